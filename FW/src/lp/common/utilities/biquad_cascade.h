@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Multichannel biquad cascade shared by EQ, crossover and other IIR based modules.
+*/
+
+#ifndef ADSP_FW_UTILITIES_BIQUAD_CASCADE_H
+#define ADSP_FW_UTILITIES_BIQUAD_CASCADE_H
+
+#include "adsp_std_defs.h"
+#include "adsp_error.h"
+#include "cpp_backward_compatibility.h"
+
+namespace dsp_fw
+{
+
+/*!
+  \brief Biquad coefficients normalized to a0 = 1:
+  H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+*/
+struct BiquadCoefs
+{
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+};
+
+/*!
+  \brief Coefficients of one stage for all lanes, structure of arrays so each
+  statement of the stage update maps onto one vector operation across channels.
+*/
+template <typename T, uint32_t LANES>
+struct BiquadStageCoefs
+{
+    T b0[LANES];
+    T b1[LANES];
+    T b2[LANES];
+    T a1[LANES];
+    T a2[LANES];
+};
+
+template <typename T, uint32_t LANES>
+struct BiquadStageState
+{
+    T s1[LANES];
+    T s2[LANES];
+};
+
+static FORCE_INLINE bool biquad_coef_valid(float value, const float*)
+{
+    return value == value;
+}
+
+/*!
+  \brief Q2.30 holds [-2, 2). A stable biquad has |a1| < 2 and |a2| < 1, larger
+  b coefficients (gain) have to be moved into another stage or the signal path.
+*/
+static FORCE_INLINE bool biquad_coef_valid(float value, const int32_t*)
+{
+    return value >= -2.0f && value < 2.0f;
+}
+
+static FORCE_INLINE void biquad_coef(float value, float* coef)
+{
+    *coef = value;
+}
+
+/*!
+  \brief Converts coefficient within [-2, 2) to Q2.30 with rounding.
+*/
+static FORCE_INLINE void biquad_coef(float value, int32_t* coef)
+{
+    const float scaled = value * 1073741824.0f;
+    // largest float below 2 scales to INT32_MAX - 127, rounding cannot overflow
+    *coef = (int32_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+}
+
+/*!
+  \brief Saturates to Q1.31 range, result stays 64-bit so lanes are not narrowed
+  between the statements of a stage.
+*/
+static FORCE_INLINE int64_t biquad_sat32(int64_t value)
+{
+    value = value > INT32_MAX ? INT32_MAX : value;
+    return value < INT32_MIN ? INT32_MIN : value;
+}
+
+/*!
+  \brief Transposed direct form II update of one stage, x holds input and receives output.
+  All loads are done before the first store, so the compiler does not have to assume
+  that state stores alias coefficients and maps every lane loop onto vector operations.
+*/
+template <uint32_t LANES>
+static FORCE_INLINE void biquad_stage(const BiquadStageCoefs<float, LANES>& c,
+                                      BiquadStageState<float, LANES>& s, float* x)
+{
+    float y[LANES], s1[LANES], s2[LANES];
+    for (uint32_t lane = 0; lane < LANES; ++lane)
+    {
+        const float in = x[lane];
+        y[lane] = c.b0[lane] * in + s.s1[lane];
+        s1[lane] = c.b1[lane] * in - c.a1[lane] * y[lane] + s.s2[lane];
+        s2[lane] = c.b2[lane] * in - c.a2[lane] * y[lane];
+    }
+    for (uint32_t lane = 0; lane < LANES; ++lane)
+    {
+        s.s1[lane] = s1[lane];
+        s.s2[lane] = s2[lane];
+        x[lane] = y[lane];
+    }
+}
+
+/*!
+  \brief Q1.31 samples and states with Q2.30 coefficients, 64-bit products.
+  Output and both states are saturated to Q1.31 in every stage, so an overloaded
+  stage clips instead of wrapping around. Every statement runs as its own loop over
+  64-bit lanes, the form in which the compiler maps it onto widening vector multiplies.
+*/
+template <uint32_t LANES>
+static FORCE_INLINE void biquad_stage(const BiquadStageCoefs<int32_t, LANES>& c,
+                                      BiquadStageState<int32_t, LANES>& s, int32_t* x)
+{
+    int64_t y[LANES], s1[LANES], s2[LANES];
+    for (uint32_t lane = 0; lane < LANES; ++lane)
+        y[lane] = biquad_sat32(((c.b0[lane] * (int64_t)x[lane]) >> 30) + s.s1[lane]);
+    for (uint32_t lane = 0; lane < LANES; ++lane)
+        s1[lane] = biquad_sat32(((c.b1[lane] * (int64_t)x[lane] - c.a1[lane] * y[lane]) >> 30) + s.s2[lane]);
+    for (uint32_t lane = 0; lane < LANES; ++lane)
+        s2[lane] = biquad_sat32((c.b2[lane] * (int64_t)x[lane] - c.a2[lane] * y[lane]) >> 30);
+    for (uint32_t lane = 0; lane < LANES; ++lane)
+    {
+        s.s1[lane] = (int32_t)s1[lane];
+        s.s2[lane] = (int32_t)s2[lane];
+        x[lane] = (int32_t)y[lane];
+    }
+}
+
+/*!
+  \brief BiquadCascade filters up to LANES interleaved channels through a cascade
+  of up to MAX_STAGES biquads, every channel having its own coefficients.
+
+  T is float or int32_t (Q1.31 samples, coefficients stored as Q2.30).
+  Channels are processed as lanes of one vector, LANES is 2, 4 or 8 and should
+  match the SIMD width of the target; unused lanes run on zero coefficients.
+  Stage updates are plain loops over lanes left to the compiler to vectorize.
+  Checked with g++ -O3 on x86: float stages become one vector operation per
+  statement with SSE2 (LANES 4, 8) and AVX2 (LANES 8), about 3x faster per channel
+  than LANES 2. int32_t stages vectorize with AVX2 only (64-bit products need
+  vpmuldq and vpcmpgtq) and gain little over scalar there. Other combinations
+  stay scalar. Code generation for HiFi has not been checked,
+  ut/biquad_cascade_test prints cost per frame to compare.
+
+  Coefficients are double buffered. SetCoefs() fills the bank not used by
+  Process() and publishes it, Process() switches banks only at the start
+  of a block. Control and processing thread may preempt each other without
+  locks; state is preserved across the update.
+  \note Both threads have to run on the same core. Banks are published behind
+  a compiler barrier only, with neither cache maintenance nor a memory barrier
+  for another core. Control running elsewhere has to forward the coefficients
+  to the processing core (e.g. through MpscQueue) and call SetCoefs() there.
+
+  Example:
+  \code
+      BiquadCascade<float, 4, 6> eq;
+      eq.Init(stages, channels, coefs);   // coefs[stage * channels + channel]
+      eq.Process(in, out, frames);
+  \endcode
+*/
+template <typename T, uint32_t LANES, uint32_t MAX_STAGES>
+class BiquadCascade
+{
+    static_assert(LANES == 2 || LANES == 4 || LANES == 8, "unsupported lane count");
+    static_assert(MAX_STAGES > 0, "empty cascade");
+
+public:
+    BiquadCascade() : stages_(0), channels_(0), active_bank_(0), published_bank_(0)
+    {
+    }
+
+    /*!
+      \brief Loads coefficients into both banks and clears state.
+      \param coefs stages * channels entries, stage major
+      \return ADSP_SUCCESS
+      \return ADSP_ERROR_INVALID_PARAM on unsupported stage or channel count, or
+              coefficient not representable in T (NaN, outside [-2, 2) for Q2.30)
+    */
+    ErrorCode Init(uint32_t stages, uint32_t channels, const BiquadCoefs* coefs)
+    {
+        if (stages == 0 || stages > MAX_STAGES || channels == 0 || channels > LANES || coefs == NULL ||
+            !CoefsValid(stages * channels, coefs))
+            return ADSP_ERROR_INVALID_PARAM;
+        stages_ = stages;
+        channels_ = channels;
+        LoadBank(0, coefs);
+        LoadBank(1, coefs);
+        active_bank_ = 0;
+        published_bank_ = 0;
+        Reset();
+        return ADSP_SUCCESS;
+    }
+
+    void Reset()
+    {
+        for (uint32_t stage = 0; stage < MAX_STAGES; ++stage)
+        {
+            for (uint32_t lane = 0; lane < LANES; ++lane)
+            {
+                state_[stage].s1[lane] = 0;
+                state_[stage].s2[lane] = 0;
+            }
+        }
+    }
+
+    /*!
+      \brief Publishes new coefficients, applied from the next Process() call.
+      Must not be called concurrently with itself or with Init().
+      \return ADSP_SUCCESS
+      \return ADSP_BUSY when previously published coefficients were not picked up yet
+      \return ADSP_ERROR_INVALID_PARAM on coefficient not representable in T,
+              coefficients in use are kept
+    */
+    ErrorCode SetCoefs(const BiquadCoefs* coefs)
+    {
+        if (coefs == NULL || !CoefsValid(stages_ * channels_, coefs))
+            return ADSP_ERROR_INVALID_PARAM;
+        const uint32_t active = active_bank_;
+        if (published_bank_ != active)
+            return ADSP_BUSY;
+        LoadBank(active ^ 1, coefs);
+        // bank contents have to land in memory before the index
+        __asm__ __volatile__("" ::: "memory");
+        published_bank_ = active ^ 1;
+        return ADSP_SUCCESS;
+    }
+
+    /*!
+      \brief Filters interleaved frames, in and out may be the same buffer.
+    */
+    void Process(const T* in, T* out, size_t frames)
+    {
+        const uint32_t bank = published_bank_;
+        __asm__ __volatile__("" ::: "memory");
+        active_bank_ = bank;
+        const BiquadStageCoefs<T, LANES>* coefs = coefs_[bank];
+        const uint32_t channels = channels_;
+        const uint32_t stages = stages_;
+
+        // coefficients and state are copied to locals for the block, so stores
+        // to out cannot alias them and they stay in vector registers
+        BiquadStageCoefs<T, LANES> c[MAX_STAGES];
+        BiquadStageState<T, LANES> state[MAX_STAGES];
+        for (uint32_t stage = 0; stage < stages; ++stage)
+        {
+            c[stage] = coefs[stage];
+            state[stage] = state_[stage];
+        }
+
+        T x[LANES];
+        for (uint32_t lane = 0; lane < LANES; ++lane)
+            x[lane] = 0;
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                x[ch] = in[ch];
+            for (uint32_t stage = 0; stage < stages; ++stage)
+                biquad_stage<LANES>(c[stage], state[stage], x);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                out[ch] = x[ch];
+            in += channels;
+            out += channels;
+        }
+
+        for (uint32_t stage = 0; stage < stages; ++stage)
+            state_[stage] = state[stage];
+    }
+
+    uint32_t GetStages() const { return stages_; }
+    uint32_t GetChannels() const { return channels_; }
+
+private:
+    static bool CoefsValid(uint32_t count, const BiquadCoefs* coefs)
+    {
+        const T* type = NULL;
+        for (uint32_t idx = 0; idx < count; ++idx)
+        {
+            const BiquadCoefs& c = coefs[idx];
+            if (!biquad_coef_valid(c.b0, type) || !biquad_coef_valid(c.b1, type) ||
+                !biquad_coef_valid(c.b2, type) || !biquad_coef_valid(c.a1, type) ||
+                !biquad_coef_valid(c.a2, type))
+                return false;
+        }
+        return true;
+    }
+
+    void LoadBank(uint32_t bank, const BiquadCoefs* coefs)
+    {
+        for (uint32_t stage = 0; stage < stages_; ++stage)
+        {
+            BiquadStageCoefs<T, LANES>& dst = coefs_[bank][stage];
+            for (uint32_t lane = 0; lane < LANES; ++lane)
+            {
+                // unused lanes are muted, their state stays at zero
+                const BiquadCoefs zero = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+                const BiquadCoefs& src = lane < channels_ ? coefs[stage * channels_ + lane] : zero;
+                biquad_coef(src.b0, &dst.b0[lane]);
+                biquad_coef(src.b1, &dst.b1[lane]);
+                biquad_coef(src.b2, &dst.b2[lane]);
+                biquad_coef(src.a1, &dst.a1[lane]);
+                biquad_coef(src.a2, &dst.a2[lane]);
+            }
+        }
+    }
+
+    BiquadStageCoefs<T, LANES> coefs_[2][MAX_STAGES];
+    BiquadStageState<T, LANES> state_[MAX_STAGES];
+    uint32_t stages_;
+    uint32_t channels_;
+    // bank used by Process(), written by processing thread only
+    volatile uint32_t active_bank_;
+    // bank to be used from next Process(), written by control thread only
+    volatile uint32_t published_bank_;
+};
+
+} // namespace dsp_fw
+
+#endif // ADSP_FW_UTILITIES_BIQUAD_CASCADE_H
@@ -2,11 +2,74 @@
 //
 // Copyright(c) 2021 Intel Corporation. All rights reserved.
 
+#include <adsp_s_memory.h>
 #include "converters.h"
 #include <xt_hifi_defs.h>
 
+#if CONVERTERS_PROFILING
+static ConverterProfile converter_profiles[CONVERTER_KERNELS_COUNT];
+
+const ConverterProfile* GetConverterProfile(ConverterKernel kernel)
+{
+    debug_assert(kernel < CONVERTER_KERNELS_COUNT);
+    return &converter_profiles[kernel];
+}
+
+void ResetConverterProfiles(void)
+{
+    memset(converter_profiles, 0, sizeof(converter_profiles));
+}
+
+/*!
+  \brief Accounts CCOUNT cycles spent from construction till end of the kernel scope.
+*/
+class ConverterProfileScope
+{
+public:
+    ConverterProfileScope(ConverterKernel kernel, const void* out, const void* in, size_t n_samples) :
+        profile_(&converter_profiles[kernel]),
+        // prologues are driven by either pointer, depending on the kernel
+        unaligned_(!IS_ALIGNED(in, 8) || !IS_ALIGNED(out, 8)),
+        odd_(n_samples % 2 != 0),
+        n_samples_(n_samples),
+        start_(xthal_get_ccount())
+    {
+    }
+
+    ~ConverterProfileScope()
+    {
+        const uint32_t cycles = xthal_get_ccount() - start_;  // overflow allowed
+        profile_->calls += 1;
+        profile_->samples += n_samples_;
+        profile_->cycles += cycles;
+        if (unaligned_)
+        {
+            profile_->unaligned_calls += 1;
+            profile_->unaligned_cycles += cycles;
+        }
+        if (odd_)
+        {
+            profile_->odd_calls += 1;
+            profile_->odd_cycles += cycles;
+        }
+    }
+private:
+    ConverterProfile* profile_;
+    bool unaligned_;
+    bool odd_;
+    size_t n_samples_;
+    uint32_t start_;
+};
+
+#define CONVERTER_PROFILE(kernel, out, in, n_samples) \
+    ConverterProfileScope converter_profile_scope(kernel, out, in, n_samples)
+#else
+#define CONVERTER_PROFILE(kernel, out, in, n_samples)
+#endif
+
 void copy_32b_cb_to_24b(int8_t* out, const int8_t* in, size_t n_samples)
 {
+    CONVERTER_PROFILE(CONVERTER_32B_CB_TO_24B, out, in, n_samples);
     const ae_f24x2* sin = (const ae_f24x2*)( in );
     ae_f24x2* sout = (ae_f24x2*)( out );
 
@@ -38,6 +101,7 @@ void copy_32b_cb_to_24b(int8_t* out, const int8_t* in, size_t n_samples)
 
 void copy_32b_to_24b(int8_t* out, const int8_t* in, size_t n_samples)
 {
+    CONVERTER_PROFILE(CONVERTER_32B_TO_24B, out, in, n_samples);
     const ae_int32* in_ptr = (const ae_int32*)(in);
 
     ae_valign align_out = AE_ZALIGN64( );
@@ -52,6 +116,7 @@ void copy_32b_to_24b(int8_t* out, const int8_t* in, size_t n_samples)
 
 void copy_24b_to_32b(int8_t* out, const int8_t* in, size_t n_samples)
 {
+    CONVERTER_PROFILE(CONVERTER_24B_TO_32B, out, in, n_samples);
     debug_assert(out != NULL);
     debug_assert(in != NULL);
     debug_assert(n_samples != 0);
@@ -90,6 +155,7 @@ void copy_24b_to_32b(int8_t* out, const int8_t* in, size_t n_samples)
 
 void copy_16b_cb_to_16b(int16_t* out, const int16_t* in, size_t n_samples)
 {
+    CONVERTER_PROFILE(CONVERTER_16B_CB_TO_16B, out, in, n_samples);
     const ae_int16x4* sin = reinterpret_cast<const ae_int16x4*> ( in );
     ae_int16x4* sout = reinterpret_cast<ae_int16x4*> ( out );
     ae_int16x4 vs;
@@ -125,6 +191,7 @@ void copy_16b_cb_to_16b(int16_t* out, const int16_t* in, size_t n_samples)
 
 void copy_32b_to_16b(int16_t* out, const int32_t* in, size_t n_samples)
 {
+    CONVERTER_PROFILE(CONVERTER_32B_TO_16B, out, in, n_samples);
     uint32_t i = 0;
     const ae_int32* in_ptr = (const ae_int32*)(in);
     ae_int16* out_ptr = (ae_int16*)(out);
@@ -139,7 +206,8 @@ void copy_32b_to_16b(int16_t* out, const int32_t* in, size_t n_samples)
     ae_int16x4* out_ptr2 = (ae_int16x4*)(out_ptr);
     const ae_int16x4* in_ptr2 = (const ae_int16x4*)(&in_ptr[i]);
     ae_valign align_out = AE_ZALIGN64();
-    for (; i < n_samples - 3; i+=4)
+    // written as i + 3 to not underflow when less than 4 samples are requested
+    for (; i + 3 < n_samples; i+=4)
     {
         ae_int16x4 d32x2_0 = *(in_ptr2++);
         ae_int16x4 d32x2_1 = *(in_ptr2++);
@@ -159,9 +227,381 @@ void copy_32b_to_16b(int16_t* out, const int32_t* in, size_t n_samples)
 
 void copy_24b_to_16b(int8_t* out, const int8_t* in, size_t n_samples)
 {
+    CONVERTER_PROFILE(CONVERTER_24B_TO_16B, out, in, n_samples);
     for (size_t idx = 0; idx < n_samples; ++idx)
     {
         out[idx*2] = in[idx * 3 + 1];
         out[idx*2+1] = in[idx * 3 + 2];
 	}
 }
+
+/*!
+  \brief Source pointer advanced by bytes within the ring currently programmed in AE_CBEGIN0/AE_CEND0.
+*/
+static const void* advance_in_current_cb(const void* ptr, size_t bytes)
+{
+    const uint8_t* c_beg = (const uint8_t*)AE_GETCBEGIN0();
+    const uint8_t* c_end = (const uint8_t*)AE_GETCEND0();
+    const uint8_t* p = (const uint8_t*)ptr + bytes;
+    if ((const uint8_t*)ptr < c_end && p >= c_end)
+    {
+        p = c_beg + (p - c_end);
+    }
+    return p;
+}
+
+/*!
+  \brief Runs linear kernel over source ring [begin, end) splitting transfer at the wrap point.
+*/
+template<typename OUT_T, typename IN_T>
+static void copy_ring_src(void (*kernel)(OUT_T*, const IN_T*, size_t),
+                          size_t in_sample_bytes, size_t out_sample_bytes,
+                          OUT_T* out, const IN_T* in, size_t n_samples,
+                          const IN_T* cb_begin, const IN_T* cb_end)
+{
+    debug_assert((const IN_T*)in >= cb_begin && (const IN_T*)in < cb_end);
+    const uint8_t* begin = (const uint8_t*)cb_begin;
+    const uint8_t* end = (const uint8_t*)cb_end;
+    const uint8_t* rd = (const uint8_t*)in;
+    uint8_t* wr = (uint8_t*)out;
+
+    while (n_samples != 0)
+    {
+        const size_t linear_samples = min(n_samples, (size_t)(end - rd) / in_sample_bytes);
+        if (linear_samples != 0)
+        {
+            kernel((OUT_T*)wr, (const IN_T*)rd, linear_samples);
+            rd += linear_samples * in_sample_bytes;
+            wr += linear_samples * out_sample_bytes;
+            n_samples -= linear_samples;
+        }
+        if (rd == end)
+        {
+            rd = begin;
+        }
+        else if (n_samples != 0)
+        {
+#pragma frequency_hint NEVER
+            // sample straddles the wrap point
+            uint32_t tmp[2];
+            const size_t head = end - rd;
+            memcpy_s(tmp, sizeof(tmp), rd, head);
+            memcpy_s((uint8_t*)tmp + head, sizeof(tmp) - head, begin, in_sample_bytes - head);
+            kernel((OUT_T*)wr, (const IN_T*)tmp, 1);
+            rd = begin + in_sample_bytes - head;
+            wr += out_sample_bytes;
+            n_samples--;
+        }
+    }
+}
+
+/*!
+  \brief Runs linear kernel into sink ring [begin, end) splitting transfer at the wrap point.
+  \param in_cb  when set, source is read through circular addressing of the kernel and
+                its pointer is advanced within ring currently programmed in AE_CBEGIN0/AE_CEND0
+*/
+template<typename OUT_T, typename IN_T>
+static void copy_ring_sink(void (*kernel)(OUT_T*, const IN_T*, size_t),
+                           size_t in_sample_bytes, size_t out_sample_bytes, bool in_cb,
+                           OUT_T* out, const IN_T* in, size_t n_samples,
+                           OUT_T* cb_begin, OUT_T* cb_end)
+{
+    debug_assert(out >= cb_begin && out < cb_end);
+    uint8_t* begin = (uint8_t*)cb_begin;
+    uint8_t* end = (uint8_t*)cb_end;
+    const uint8_t* rd = (const uint8_t*)in;
+    uint8_t* wr = (uint8_t*)out;
+
+    while (n_samples != 0)
+    {
+        const size_t linear_samples = min(n_samples, (size_t)(end - wr) / out_sample_bytes);
+        if (linear_samples != 0)
+        {
+            kernel((OUT_T*)wr, (const IN_T*)rd, linear_samples);
+            rd = in_cb ? (const uint8_t*)advance_in_current_cb(rd, linear_samples * in_sample_bytes)
+                       : rd + linear_samples * in_sample_bytes;
+            wr += linear_samples * out_sample_bytes;
+            n_samples -= linear_samples;
+        }
+        if (wr == end)
+        {
+            wr = begin;
+        }
+        else if (n_samples != 0)
+        {
+#pragma frequency_hint NEVER
+            // sample straddles the wrap point
+            uint32_t tmp[2];
+            const size_t head = end - wr;
+            kernel((OUT_T*)tmp, (const IN_T*)rd, 1);
+            memcpy_s(wr, head, tmp, head);
+            memcpy_s(begin, end - begin, (uint8_t*)tmp + head, out_sample_bytes - head);
+            rd = in_cb ? (const uint8_t*)advance_in_current_cb(rd, in_sample_bytes)
+                       : rd + in_sample_bytes;
+            wr = begin + out_sample_bytes - head;
+            n_samples--;
+        }
+    }
+}
+
+/*!
+  \brief Programs AE_CBEGIN0/AE_CEND0 for the lifetime of the object and restores previous setting.
+*/
+class CircularAddressingScope
+{
+public:
+    CircularAddressingScope(const void* cb_begin, const void* cb_end) :
+        cached_c_beg_(AE_GETCBEGIN0()),
+        cached_c_end_(AE_GETCEND0())
+    {
+        AE_SETCBEGIN0(cb_begin);
+        AE_SETCEND0(cb_end);
+    }
+    ~CircularAddressingScope()
+    {
+        AE_SETCBEGIN0(cached_c_beg_);
+        AE_SETCEND0(cached_c_end_);
+    }
+private:
+    void* cached_c_beg_;
+    void* cached_c_end_;
+};
+
+void copy_32b_cb_to_24b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                                 const int8_t* cb_begin, const int8_t* cb_end)
+{
+    CircularAddressingScope cb(cb_begin, cb_end);
+    copy_32b_cb_to_24b(out, in, n_samples);
+}
+
+void copy_24b_to_32b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                              const int8_t* cb_begin, const int8_t* cb_end)
+{
+    copy_ring_src(copy_24b_to_32b, 3, 4, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_32b_to_24b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                              const int8_t* cb_begin, const int8_t* cb_end)
+{
+    copy_ring_src(copy_32b_to_24b, 4, 3, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_24b_to_16b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                              const int8_t* cb_begin, const int8_t* cb_end)
+{
+    copy_ring_src(copy_24b_to_16b, 3, 2, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_16b_cb_to_16b_ring_src(int16_t* out, const int16_t* in, size_t n_samples,
+                                 const int16_t* cb_begin, const int16_t* cb_end)
+{
+    CircularAddressingScope cb(cb_begin, cb_end);
+    copy_16b_cb_to_16b(out, in, n_samples);
+}
+
+void copy_32b_to_16b_ring_src(int16_t* out, const int32_t* in, size_t n_samples,
+                              const int32_t* cb_begin, const int32_t* cb_end)
+{
+    copy_ring_src(copy_32b_to_16b, 4, 2, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_32b_cb_to_24b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                                  int8_t* cb_begin, int8_t* cb_end)
+{
+    copy_ring_sink(copy_32b_cb_to_24b, 4, 3, true, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_24b_to_32b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                               int8_t* cb_begin, int8_t* cb_end)
+{
+    copy_ring_sink(copy_24b_to_32b, 3, 4, false, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_32b_to_24b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                               int8_t* cb_begin, int8_t* cb_end)
+{
+    copy_ring_sink(copy_32b_to_24b, 4, 3, false, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_24b_to_16b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                               int8_t* cb_begin, int8_t* cb_end)
+{
+    copy_ring_sink(copy_24b_to_16b, 3, 2, false, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_16b_cb_to_16b_ring_sink(int16_t* out, const int16_t* in, size_t n_samples,
+                                  int16_t* cb_begin, int16_t* cb_end)
+{
+    copy_ring_sink(copy_16b_cb_to_16b, 2, 2, true, out, in, n_samples, cb_begin, cb_end);
+}
+
+void copy_32b_to_16b_ring_sink(int16_t* out, const int32_t* in, size_t n_samples,
+                               int16_t* cb_begin, int16_t* cb_end)
+{
+    copy_ring_sink(copy_32b_to_16b, 4, 2, false, out, in, n_samples, cb_begin, cb_end);
+}
+
+void ConverterMeterReset(ConverterMeter* meter, uint32_t channels)
+{
+    debug_assert(meter != NULL);
+    debug_assert(channels != 0 && channels <= CONVERTER_METER_MAX_CHANNELS);
+    memset(meter, 0, sizeof(*meter));
+    meter->channels = channels;
+}
+
+/*!
+  \brief Level statistics of a single channel, held in registers while its samples are processed.
+*/
+struct MeterChannel
+{
+    int32_t peak;
+    uint64_t sum_squares;
+    uint32_t clip_count;
+    uint32_t sample_count;
+
+    MeterChannel(const ConverterMeter* meter, uint32_t ch) :
+        peak(meter->peak[ch]),
+        sum_squares(meter->sum_squares[ch]),
+        clip_count(meter->clip_count[ch]),
+        sample_count(meter->sample_count[ch])
+    {
+    }
+
+    /*!
+      \brief Accumulates single sample normalized to Q1.31.
+    */
+    FORCE_INLINE void Add(int32_t q31, bool clipped)
+    {
+        // abs(INT32_MIN) saturates to INT32_MAX
+        const int32_t magnitude = (q31 < 0) ? ((q31 == INT32_MIN) ? INT32_MAX : -q31) : q31;
+        const int32_t q15 = q31 >> 16;
+        peak = (magnitude > peak) ? magnitude : peak;
+        sum_squares += (uint64_t)(q15 * q15);
+        clip_count += clipped ? 1 : 0;
+    }
+
+    void Store(ConverterMeter* meter, uint32_t ch, uint32_t samples) const
+    {
+        meter->peak[ch] = peak;
+        meter->sum_squares[ch] = sum_squares;
+        meter->clip_count[ch] = clip_count;
+        meter->sample_count[ch] = sample_count + samples;
+    }
+};
+
+/*!
+  \brief Runs conversion channel by channel over interleaved samples, so statistics of
+  the channel stay in locals and are written back to meter once per call.
+  KERNEL::Convert(out, in, idx, &clipped) converts sample idx and returns it as Q1.31.
+*/
+template<class KERNEL, typename OUT_T, typename IN_T>
+static void copy_meter(OUT_T* out, const IN_T* in, size_t n_samples, ConverterMeter* meter)
+{
+    debug_assert(meter != NULL && meter->channels != 0);
+    const uint32_t channels = meter->channels;
+    uint32_t ch = meter->next_channel;
+    for (size_t first = 0; first < channels && first < n_samples; ++first)
+    {
+        MeterChannel acc(meter, ch);
+        uint32_t samples = 0;
+        for (size_t idx = first; idx < n_samples; idx += channels)
+        {
+            bool clipped;
+            const int32_t q31 = KERNEL::Convert(out, in, idx, &clipped);
+            acc.Add(q31, clipped);
+            ++samples;
+        }
+        acc.Store(meter, ch, samples);
+        if (++ch == channels)
+        {
+            ch = 0;
+        }
+    }
+    meter->next_channel = (uint32_t)((meter->next_channel + n_samples) % channels);
+}
+
+static FORCE_INLINE int32_t load_24b(const int8_t* in)
+{
+    const uint8_t* b = (const uint8_t*)in;
+    // sign extension by shifting the most significant byte through the 32-bit container
+    return (int32_t)(((uint32_t)b[0] << 8) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 24)) >> 8;
+}
+
+static FORCE_INLINE void store_24b(int8_t* out, int32_t d24)
+{
+    out[0] = (int8_t)d24;
+    out[1] = (int8_t)(d24 >> 8);
+    out[2] = (int8_t)(d24 >> 16);
+}
+
+#define INT24_MAX 0x7FFFFF
+#define INT24_MIN (-0x800000)
+
+struct Meter24bTo32b
+{
+    static FORCE_INLINE int32_t Convert(int8_t* out, const int8_t* in, size_t idx, bool* clipped)
+    {
+        const int32_t d24 = load_24b(in + idx * 3);
+        const int32_t d32 = (int32_t)((uint32_t)d24 << 8);
+        ((int32_t*)out)[idx] = d32;
+        // widening conversion, largest magnitudes it can produce are the source full scale
+        *clipped = d24 == INT24_MAX || d24 == INT24_MIN;
+        return d32;
+    }
+};
+
+struct Meter32bTo24b
+{
+    static FORCE_INLINE int32_t Convert(int8_t* out, const int8_t* in, size_t idx, bool* clipped)
+    {
+        const int32_t d32 = ((const int32_t*)in)[idx];
+        const int32_t d24 = d32 >> 8;
+        store_24b(out + idx * 3, d24);
+        *clipped = d24 == INT24_MAX || d24 == INT24_MIN;
+        return d32;
+    }
+};
+
+struct Meter24bTo16b
+{
+    static FORCE_INLINE int32_t Convert(int8_t* out, const int8_t* in, size_t idx, bool* clipped)
+    {
+        const int32_t d32 = (int32_t)((uint32_t)load_24b(in + idx * 3) << 8);
+        const int16_t d16 = (int16_t)(d32 >> 16);
+        ((int16_t*)out)[idx] = d16;
+        *clipped = d16 == INT16_MAX || d16 == INT16_MIN;
+        return d32;
+    }
+};
+
+struct Meter32bTo16b
+{
+    static FORCE_INLINE int32_t Convert(int16_t* out, const int32_t* in, size_t idx, bool* clipped)
+    {
+        const int32_t d32 = in[idx];
+        const int16_t d16 = (int16_t)(d32 >> 16);
+        out[idx] = d16;
+        *clipped = d16 == INT16_MAX || d16 == INT16_MIN;
+        return d32;
+    }
+};
+
+void copy_24b_to_32b_meter(int8_t* out, const int8_t* in, size_t n_samples, ConverterMeter* meter)
+{
+    copy_meter<Meter24bTo32b>(out, in, n_samples, meter);
+}
+
+void copy_32b_to_24b_meter(int8_t* out, const int8_t* in, size_t n_samples, ConverterMeter* meter)
+{
+    copy_meter<Meter32bTo24b>(out, in, n_samples, meter);
+}
+
+void copy_24b_to_16b_meter(int8_t* out, const int8_t* in, size_t n_samples, ConverterMeter* meter)
+{
+    copy_meter<Meter24bTo16b>(out, in, n_samples, meter);
+}
+
+void copy_32b_to_16b_meter(int16_t* out, const int32_t* in, size_t n_samples, ConverterMeter* meter)
+{
+    copy_meter<Meter32bTo16b>(out, in, n_samples, meter);
+}
@@ -7,6 +7,73 @@
 
 #include "adsp_std_defs.h"
 
+#define CONVERTER_METER_MAX_CHANNELS 8
+
+/*!
+  \brief Per-channel level statistics gathered as a by-product of sample conversion.
+  Statistics are accumulated over consecutive calls until ConverterMeterReset() is called,
+  a call may end in the middle of a frame (next_channel keeps track of interleaving).
+  All levels are normalized to the 32-bit container regardless of the sample format.
+ */
+typedef struct _ConverterMeter
+{
+    uint32_t channels;
+    // channel of the first sample processed by the next call
+    uint32_t next_channel;
+    // maximum absolute sample value (Q1.31)
+    int32_t peak[CONVERTER_METER_MAX_CHANNELS];
+    // sum of squares of the 16 most significant bits of samples (Q1.15 * Q1.15)
+    uint64_t sum_squares[CONVERTER_METER_MAX_CHANNELS];
+    // number of samples that reached the full scale of the narrower of source and destination
+    // format, i.e. the largest magnitude the conversion can produce
+    uint32_t clip_count[CONVERTER_METER_MAX_CHANNELS];
+    uint32_t sample_count[CONVERTER_METER_MAX_CHANNELS];
+} ConverterMeter;
+
+#if CONVERTERS_PROFILING
+/*!
+  \brief Kernels instrumented when CONVERTERS_PROFILING is enabled.
+ */
+typedef enum _ConverterKernel
+{
+    CONVERTER_32B_CB_TO_24B = 0,
+    CONVERTER_24B_TO_32B,
+    CONVERTER_32B_TO_24B,
+    CONVERTER_24B_TO_16B,
+    CONVERTER_16B_CB_TO_16B,
+    CONVERTER_32B_TO_16B,
+    CONVERTER_KERNELS_COUNT
+} ConverterKernel;
+
+/*!
+  \brief Cycle statistics of a single kernel.
+  Calls with misaligned source or destination (which go through the IS_ALIGNED prologues) and calls
+  with odd sample count (which go through the tail handling) are accounted separately
+  as well, so cycles per sample can be compared between those and the main path.
+ */
+typedef struct _ConverterProfile
+{
+    uint32_t calls;
+    // 64-bit accumulators, 32 bits of cycles wrap within seconds
+    uint64_t samples;
+    uint64_t cycles;
+    uint32_t unaligned_calls;
+    uint64_t unaligned_cycles;
+    uint32_t odd_calls;
+    uint64_t odd_cycles;
+} ConverterProfile;
+
+/*!
+  \brief Retrieves statistics gathered for kernel since last ResetConverterProfiles().
+*/
+const ConverterProfile* GetConverterProfile(ConverterKernel kernel);
+
+/*!
+  \brief Clears statistics of all kernels, e.g. before measuring next block size.
+*/
+void ResetConverterProfiles(void);
+#endif
+
 void copy_32b_cb_to_24b(int8_t* out, const int8_t* in, size_t n_samples);
 void copy_24b_to_32b(int8_t* out, const int8_t* in, size_t n_samples);
 void copy_32b_to_24b(int8_t* out, const int8_t* in, size_t n_samples);
@@ -14,4 +81,78 @@ void copy_24b_to_16b(int8_t* out, const int8_t* in, size_t n_samples);
 void copy_16b_cb_to_16b(int16_t* out, const int16_t* in, size_t n_samples);
 void copy_32b_to_16b(int16_t* out, const int32_t* in, size_t n_samples);
 
+/*!
+  \brief G.711 codecs, A-law/mu-law bytes to/from linear 16-bit samples.
+*/
+void copy_alaw_to_16b(int16_t* out, const uint8_t* in, size_t n_samples);
+void copy_mulaw_to_16b(int16_t* out, const uint8_t* in, size_t n_samples);
+void copy_16b_to_alaw(uint8_t* out, const int16_t* in, size_t n_samples);
+void copy_16b_to_mulaw(uint8_t* out, const int16_t* in, size_t n_samples);
+
+/*!
+  \brief Byte-swapping converters for big-endian PCM.
+  copy_16b_bswap and copy_32b_bswap are symmetric (work in both directions),
+  24-bit variants convert packed big-endian samples from/to 32-bit native container.
+  \note These and the G.711 codecs are portable C, there are no AE_* variants yet.
+        On host (ut/converters_bench_host.txt) byte swapping costs 0.5-0.8 ns per sample
+        against 0.02-0.05 ns of a native PCM copy, i.e. 10-30x more, G.711 decoding is
+        similar and G.711 encoding over 100x. ut/converters_bench gives HiFi cycles.
+*/
+void copy_16b_bswap(int16_t* out, const int16_t* in, size_t n_samples);
+void copy_32b_bswap(int32_t* out, const int32_t* in, size_t n_samples);
+void copy_24b_be_to_32b(int8_t* out, const int8_t* in, size_t n_samples);
+void copy_32b_to_24b_be(int8_t* out, const int8_t* in, size_t n_samples);
+
+/*!
+  \brief Circular addressing variants of the converters.
+  ring_src variants read n_samples starting at in from the ring [cb_begin, cb_end),
+  ring_sink variants write n_samples starting at out into the ring [cb_begin, cb_end).
+  Transfers are wrapped at cb_end by the converter, so callers do not have to split them.
+  Kernels that read through HiFi circular addressing (*_cb_*) get source ring programmed
+  into AE_CBEGIN0/AE_CEND0 (previous setting is restored on exit), other kernels are split
+  at the wrap point, with a sample straddling cb_end (24-bit packed data) being linearized.
+  \note *_cb_* ring_sink variants read the source through the current AE_CBEGIN0/AE_CEND0.
+*/
+void copy_32b_cb_to_24b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                                 const int8_t* cb_begin, const int8_t* cb_end);
+void copy_24b_to_32b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                              const int8_t* cb_begin, const int8_t* cb_end);
+void copy_32b_to_24b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                              const int8_t* cb_begin, const int8_t* cb_end);
+void copy_24b_to_16b_ring_src(int8_t* out, const int8_t* in, size_t n_samples,
+                              const int8_t* cb_begin, const int8_t* cb_end);
+void copy_16b_cb_to_16b_ring_src(int16_t* out, const int16_t* in, size_t n_samples,
+                                 const int16_t* cb_begin, const int16_t* cb_end);
+void copy_32b_to_16b_ring_src(int16_t* out, const int32_t* in, size_t n_samples,
+                              const int32_t* cb_begin, const int32_t* cb_end);
+
+void copy_32b_cb_to_24b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                                  int8_t* cb_begin, int8_t* cb_end);
+void copy_24b_to_32b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                               int8_t* cb_begin, int8_t* cb_end);
+void copy_32b_to_24b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                               int8_t* cb_begin, int8_t* cb_end);
+void copy_24b_to_16b_ring_sink(int8_t* out, const int8_t* in, size_t n_samples,
+                               int8_t* cb_begin, int8_t* cb_end);
+void copy_16b_cb_to_16b_ring_sink(int16_t* out, const int16_t* in, size_t n_samples,
+                                  int16_t* cb_begin, int16_t* cb_end);
+void copy_32b_to_16b_ring_sink(int16_t* out, const int32_t* in, size_t n_samples,
+                               int16_t* cb_begin, int16_t* cb_end);
+
+/*!
+  \brief Clears statistics and sets number of interleaved channels (up to CONVERTER_METER_MAX_CHANNELS).
+*/
+void ConverterMeterReset(ConverterMeter* meter, uint32_t channels);
+
+/*!
+  \brief Metering variants of the converters.
+  Output is identical to the corresponding plain converter, peak, sum of squares
+  and clip count of every sample are accumulated into meter on the way,
+  so there is no need to read the buffer again after conversion.
+*/
+void copy_24b_to_32b_meter(int8_t* out, const int8_t* in, size_t n_samples, ConverterMeter* meter);
+void copy_32b_to_24b_meter(int8_t* out, const int8_t* in, size_t n_samples, ConverterMeter* meter);
+void copy_24b_to_16b_meter(int8_t* out, const int8_t* in, size_t n_samples, ConverterMeter* meter);
+void copy_32b_to_16b_meter(int16_t* out, const int32_t* in, size_t n_samples, ConverterMeter* meter);
+
 #endif //_ADSP_FW_CONVERTERS_H
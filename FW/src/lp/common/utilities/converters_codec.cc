@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#include "converters.h"
+
+/*
+ * G.711 expansion tables, index is the encoded byte, value is linear 16-bit sample.
+ */
+static const int16_t alaw_to_16b_table[256] = {
+     -5504,  -5248,  -6016,  -5760,  -4480,  -4224,  -4992,  -4736,
+     -7552,  -7296,  -8064,  -7808,  -6528,  -6272,  -7040,  -6784,
+     -2752,  -2624,  -3008,  -2880,  -2240,  -2112,  -2496,  -2368,
+     -3776,  -3648,  -4032,  -3904,  -3264,  -3136,  -3520,  -3392,
+    -22016, -20992, -24064, -23040, -17920, -16896, -19968, -18944,
+    -30208, -29184, -32256, -31232, -26112, -25088, -28160, -27136,
+    -11008, -10496, -12032, -11520,  -8960,  -8448,  -9984,  -9472,
+    -15104, -14592, -16128, -15616, -13056, -12544, -14080, -13568,
+      -344,   -328,   -376,   -360,   -280,   -264,   -312,   -296,
+      -472,   -456,   -504,   -488,   -408,   -392,   -440,   -424,
+       -88,    -72,   -120,   -104,    -24,     -8,    -56,    -40,
+      -216,   -200,   -248,   -232,   -152,   -136,   -184,   -168,
+     -1376,  -1312,  -1504,  -1440,  -1120,  -1056,  -1248,  -1184,
+     -1888,  -1824,  -2016,  -1952,  -1632,  -1568,  -1760,  -1696,
+      -688,   -656,   -752,   -720,   -560,   -528,   -624,   -592,
+      -944,   -912,  -1008,   -976,   -816,   -784,   -880,   -848,
+      5504,   5248,   6016,   5760,   4480,   4224,   4992,   4736,
+      7552,   7296,   8064,   7808,   6528,   6272,   7040,   6784,
+      2752,   2624,   3008,   2880,   2240,   2112,   2496,   2368,
+      3776,   3648,   4032,   3904,   3264,   3136,   3520,   3392,
+     22016,  20992,  24064,  23040,  17920,  16896,  19968,  18944,
+     30208,  29184,  32256,  31232,  26112,  25088,  28160,  27136,
+     11008,  10496,  12032,  11520,   8960,   8448,   9984,   9472,
+     15104,  14592,  16128,  15616,  13056,  12544,  14080,  13568,
+       344,    328,    376,    360,    280,    264,    312,    296,
+       472,    456,    504,    488,    408,    392,    440,    424,
+        88,     72,    120,    104,     24,      8,     56,     40,
+       216,    200,    248,    232,    152,    136,    184,    168,
+      1376,   1312,   1504,   1440,   1120,   1056,   1248,   1184,
+      1888,   1824,   2016,   1952,   1632,   1568,   1760,   1696,
+       688,    656,    752,    720,    560,    528,    624,    592,
+       944,    912,   1008,    976,    816,    784,    880,    848
+};
+
+static const int16_t mulaw_to_16b_table[256] = {
+    -32124, -31100, -30076, -29052, -28028, -27004, -25980, -24956,
+    -23932, -22908, -21884, -20860, -19836, -18812, -17788, -16764,
+    -15996, -15484, -14972, -14460, -13948, -13436, -12924, -12412,
+    -11900, -11388, -10876, -10364,  -9852,  -9340,  -8828,  -8316,
+     -7932,  -7676,  -7420,  -7164,  -6908,  -6652,  -6396,  -6140,
+     -5884,  -5628,  -5372,  -5116,  -4860,  -4604,  -4348,  -4092,
+     -3900,  -3772,  -3644,  -3516,  -3388,  -3260,  -3132,  -3004,
+     -2876,  -2748,  -2620,  -2492,  -2364,  -2236,  -2108,  -1980,
+     -1884,  -1820,  -1756,  -1692,  -1628,  -1564,  -1500,  -1436,
+     -1372,  -1308,  -1244,  -1180,  -1116,  -1052,   -988,   -924,
+      -876,   -844,   -812,   -780,   -748,   -716,   -684,   -652,
+      -620,   -588,   -556,   -524,   -492,   -460,   -428,   -396,
+      -372,   -356,   -340,   -324,   -308,   -292,   -276,   -260,
+      -244,   -228,   -212,   -196,   -180,   -164,   -148,   -132,
+      -120,   -112,   -104,    -96,    -88,    -80,    -72,    -64,
+       -56,    -48,    -40,    -32,    -24,    -16,     -8,      0,
+     32124,  31100,  30076,  29052,  28028,  27004,  25980,  24956,
+     23932,  22908,  21884,  20860,  19836,  18812,  17788,  16764,
+     15996,  15484,  14972,  14460,  13948,  13436,  12924,  12412,
+     11900,  11388,  10876,  10364,   9852,   9340,   8828,   8316,
+      7932,   7676,   7420,   7164,   6908,   6652,   6396,   6140,
+      5884,   5628,   5372,   5116,   4860,   4604,   4348,   4092,
+      3900,   3772,   3644,   3516,   3388,   3260,   3132,   3004,
+      2876,   2748,   2620,   2492,   2364,   2236,   2108,   1980,
+      1884,   1820,   1756,   1692,   1628,   1564,   1500,   1436,
+      1372,   1308,   1244,   1180,   1116,   1052,    988,    924,
+       876,    844,    812,    780,    748,    716,    684,    652,
+       620,    588,    556,    524,    492,    460,    428,    396,
+       372,    356,    340,    324,    308,    292,    276,    260,
+       244,    228,    212,    196,    180,    164,    148,    132,
+       120,    112,    104,     96,     88,     80,     72,     64,
+        56,     48,     40,     32,     24,     16,      8,      0
+};
+
+/*!
+  \brief Number of significant bits of value (0 for 0).
+*/
+static FORCE_INLINE uint32_t bit_length(uint32_t value)
+{
+    return 32 - __builtin_clz(value | 1) - (value == 0 ? 1 : 0);
+}
+
+static FORCE_INLINE uint8_t encode_alaw(int16_t sample)
+{
+    int32_t pcm = sample >> 3;
+    uint8_t mask = 0xD5;
+    if (pcm < 0)
+    {
+        mask = 0x55;
+        pcm = -pcm - 1;
+    }
+    // segment ends are 0x1F, 0x3F, ... 0xFFF, i.e. segment is bit length over 5
+    const int32_t seg = max((int32_t)bit_length(pcm) - 5, (int32_t)0);
+    const int32_t quant = (pcm >> max(seg, (int32_t)1)) & 0xF;
+    return (uint8_t)(((seg << 4) | quant) ^ mask);
+}
+
+#define MULAW_BIAS 0x84
+#define MULAW_CLIP 8159
+
+static FORCE_INLINE uint8_t encode_mulaw(int16_t sample)
+{
+    int32_t pcm = sample >> 2;
+    uint8_t mask = 0xFF;
+    if (pcm < 0)
+    {
+        mask = 0x7F;
+        pcm = -pcm;
+    }
+    pcm = min(pcm, (int32_t)MULAW_CLIP) + (MULAW_BIAS >> 2);
+    // segment ends are 0x3F, 0x7F, ... 0x1FFF, i.e. segment is bit length over 6
+    const int32_t seg = max((int32_t)bit_length(pcm) - 6, (int32_t)0);
+    if (seg >= 8)
+    {
+        // clipped (biased) value falls beyond the last segment
+        return (uint8_t)(0x7F ^ mask);
+    }
+    return (uint8_t)(((seg << 4) | ((pcm >> (seg + 1)) & 0xF)) ^ mask);
+}
+
+void copy_alaw_to_16b(int16_t* out, const uint8_t* in, size_t n_samples)
+{
+    for (size_t idx = 0; idx < n_samples; ++idx)
+    {
+        out[idx] = alaw_to_16b_table[in[idx]];
+    }
+}
+
+void copy_mulaw_to_16b(int16_t* out, const uint8_t* in, size_t n_samples)
+{
+    for (size_t idx = 0; idx < n_samples; ++idx)
+    {
+        out[idx] = mulaw_to_16b_table[in[idx]];
+    }
+}
+
+void copy_16b_to_alaw(uint8_t* out, const int16_t* in, size_t n_samples)
+{
+    for (size_t idx = 0; idx < n_samples; ++idx)
+    {
+        out[idx] = encode_alaw(in[idx]);
+    }
+}
+
+void copy_16b_to_mulaw(uint8_t* out, const int16_t* in, size_t n_samples)
+{
+    for (size_t idx = 0; idx < n_samples; ++idx)
+    {
+        out[idx] = encode_mulaw(in[idx]);
+    }
+}
+
+static FORCE_INLINE uint32_t bswap_32(uint32_t d32)
+{
+    const uint32_t d16x2 = ((d32 & 0x00FF00FF) << 8) | ((d32 >> 8) & 0x00FF00FF);
+    return (d16x2 << 16) | (d16x2 >> 16);
+}
+
+void copy_16b_bswap(int16_t* out, const int16_t* in, size_t n_samples)
+{
+    size_t idx = 0;
+    if (IS_ALIGNED(in, 4) && IS_ALIGNED(out, 4))
+    {
+        // swap two samples at once
+        const uint32_t* in_ptr = (const uint32_t*)(in);
+        uint32_t* out_ptr = (uint32_t*)(out);
+        for (; idx + 1 < n_samples; idx += 2)
+        {
+            const uint32_t d32 = *(in_ptr++);
+            *(out_ptr++) = ((d32 & 0x00FF00FF) << 8) | ((d32 >> 8) & 0x00FF00FF);
+        }
+    }
+    for (; idx < n_samples; ++idx)
+    {
+        const uint16_t d16 = (uint16_t)in[idx];
+        out[idx] = (int16_t)((d16 << 8) | (d16 >> 8));
+    }
+}
+
+void copy_32b_bswap(int32_t* out, const int32_t* in, size_t n_samples)
+{
+    for (size_t idx = 0; idx < n_samples; ++idx)
+    {
+        out[idx] = (int32_t)bswap_32((uint32_t)in[idx]);
+    }
+}
+
+/*
+ * Packed 24-bit variants move four samples through three 32-bit words per iteration
+ * when the packed side is word aligned (little-endian words, as on Xtensa and x86),
+ * so there are 7 memory accesses per 4 samples instead of 16.
+ */
+void copy_24b_be_to_32b(int8_t* out, const int8_t* in, size_t n_samples)
+{
+    const uint8_t* in_ptr = (const uint8_t*)(in);
+    uint32_t* out_ptr = (uint32_t*)(out);
+    size_t idx = 0;
+    if (IS_ALIGNED(in_ptr, 4))
+    {
+        const uint32_t* in_words = (const uint32_t*)(in_ptr);
+        for (; idx + 3 < n_samples; idx += 4)
+        {
+            // bytes of samples 0..3 are AAAB BBCC CDDD in memory
+            const uint32_t w0 = bswap_32(in_words[0]);
+            const uint32_t w1 = bswap_32(in_words[1]);
+            const uint32_t w2 = bswap_32(in_words[2]);
+            in_words += 3;
+            out_ptr[idx] = w0 & 0xFFFFFF00;
+            out_ptr[idx + 1] = (w0 << 24) | ((w1 >> 8) & 0x00FFFF00);
+            out_ptr[idx + 2] = (w1 << 16) | ((w2 >> 16) & 0x0000FF00);
+            out_ptr[idx + 3] = w2 << 8;
+        }
+        in_ptr = (const uint8_t*)(in_words);
+    }
+    for (; idx < n_samples; ++idx)
+    {
+        out_ptr[idx] = ((uint32_t)in_ptr[0] << 24) |
+                       ((uint32_t)in_ptr[1] << 16) |
+                       ((uint32_t)in_ptr[2] << 8);
+        in_ptr += 3;
+    }
+}
+
+void copy_32b_to_24b_be(int8_t* out, const int8_t* in, size_t n_samples)
+{
+    const uint32_t* in_ptr = (const uint32_t*)(in);
+    size_t idx = 0;
+    if (IS_ALIGNED(out, 4))
+    {
+        uint32_t* out_words = (uint32_t*)(out);
+        for (; idx + 3 < n_samples; idx += 4)
+        {
+            const uint32_t d0 = in_ptr[idx];
+            const uint32_t d1 = in_ptr[idx + 1];
+            const uint32_t d2 = in_ptr[idx + 2];
+            const uint32_t d3 = in_ptr[idx + 3];
+            out_words[0] = bswap_32((d0 & 0xFFFFFF00) | (d1 >> 24));
+            out_words[1] = bswap_32((d1 << 8 & 0xFFFF0000) | (d2 >> 16));
+            out_words[2] = bswap_32((d2 << 16 & 0xFF000000) | (d3 >> 8));
+            out_words += 3;
+        }
+        out = (int8_t*)(out_words);
+    }
+    for (; idx < n_samples; ++idx)
+    {
+        const uint32_t d32 = in_ptr[idx];
+        out[0] = (int8_t)(d32 >> 24);
+        out[1] = (int8_t)(d32 >> 16);
+        out[2] = (int8_t)(d32 >> 8);
+        out += 3;
+    }
+}
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef CPP_INLINE_QUEUE_H
+#define CPP_INLINE_QUEUE_H
+
+#include <new>
+#include "adsp_std_defs.h"
+#include "adsp_assert.h"
+#include "adsp_error.h"
+#include "cpp_backward_compatibility.h"
+#include "platform/memory_defs.h"
+
+/*!
+  \brief FIFO of T stored inline in a power-of-two ring.
+  Unlike CppSimpleQueue there is no separate pointer array and no SimpleQueue
+  behind it: a slot is owned by the queue from push until pop, so it cannot be
+  handed out while still queued, and an access is one masked index.
+  Indices run freely, the element count is rear_ - front_.
+
+  Elements are constructed in place either by Emplace() or by the caller
+  between BeginPush() and CommitPush(), and destroyed by QPop().
+
+  Example:
+  \code
+      CppInlineQueue<Request, 8> requests;
+      requests.Emplace(id, size);
+      Request* slot = requests.BeginPush();
+      if (slot != NULL)
+      {
+          slot->id = id;
+          requests.CommitPush();
+      }
+      while (!requests.IsEmpty())
+      {
+          Handle(*requests.Front());
+          requests.QPop();
+      }
+  \endcode
+*/
+template<typename T, uint32_t SIZE>
+class CppInlineQueue
+{
+    static_assert(SIZE > 0 && (SIZE & (SIZE - 1)) == 0, "queue size has to be power of two");
+
+public:
+    CppInlineQueue() : rear_(0), front_(0) {}
+
+    ~CppInlineQueue()
+    {
+        ResetQueue();
+    }
+
+    /*!
+      \brief Destroys all queued elements.
+    */
+    void ResetQueue()
+    {
+        while (!IsEmpty())
+            QPop();
+        rear_ = front_ = 0;
+    }
+
+    bool IsEmpty() const { return rear_ == front_; }
+    bool IsFull() const { return rear_ - front_ == SIZE; }
+    uint32_t GetElementsCount() const { return rear_ - front_; }
+
+    /*!
+      \brief Copies element into the queue.
+      \return ADSP_SIMPLE_QUEUE_FULL when there is no space
+    */
+    ErrorCode QPush(const T& element)
+    {
+        RETURN_EC_ON_FAIL(!IsFull(), ADSP_SIMPLE_QUEUE_FULL);
+        new (Slot(rear_)) T(element);
+        ++rear_;
+        return ADSP_SUCCESS;
+    }
+
+    /*!
+      \brief Constructs element in place from given constructor arguments.
+      \return ADSP_SIMPLE_QUEUE_FULL when there is no space
+    */
+    ErrorCode Emplace()
+    {
+        RETURN_EC_ON_FAIL(!IsFull(), ADSP_SIMPLE_QUEUE_FULL);
+        new (Slot(rear_)) T();
+        ++rear_;
+        return ADSP_SUCCESS;
+    }
+
+    template<typename A1>
+    ErrorCode Emplace(const A1& a1)
+    {
+        RETURN_EC_ON_FAIL(!IsFull(), ADSP_SIMPLE_QUEUE_FULL);
+        new (Slot(rear_)) T(a1);
+        ++rear_;
+        return ADSP_SUCCESS;
+    }
+
+    template<typename A1, typename A2>
+    ErrorCode Emplace(const A1& a1, const A2& a2)
+    {
+        RETURN_EC_ON_FAIL(!IsFull(), ADSP_SIMPLE_QUEUE_FULL);
+        new (Slot(rear_)) T(a1, a2);
+        ++rear_;
+        return ADSP_SUCCESS;
+    }
+
+    template<typename A1, typename A2, typename A3>
+    ErrorCode Emplace(const A1& a1, const A2& a2, const A3& a3)
+    {
+        RETURN_EC_ON_FAIL(!IsFull(), ADSP_SIMPLE_QUEUE_FULL);
+        new (Slot(rear_)) T(a1, a2, a3);
+        ++rear_;
+        return ADSP_SUCCESS;
+    }
+
+    /*!
+      \brief Returns storage of the next slot, NULL when full.
+      Element becomes queued by CommitPush(); until then the caller constructs it
+      (placement new, or plain member writes for POD types).
+    */
+    T* BeginPush()
+    {
+        return IsFull() ? NULL : Slot(rear_);
+    }
+
+    void CommitPush()
+    {
+        assert(!IsFull());
+        ++rear_;
+    }
+
+    /*!
+      \brief Returns the oldest element in place, NULL when empty.
+    */
+    T* Front()
+    {
+        return IsEmpty() ? NULL : Slot(front_);
+    }
+
+    const T* Front() const
+    {
+        return IsEmpty() ? NULL : Slot(front_);
+    }
+
+    /*!
+      \brief Retrieves (when element is not NULL) and destroys the oldest element.
+      \return ADSP_SIMPLE_QUEUE_EMPTY when there is nothing to pop
+    */
+    ErrorCode QPop(T* element = NULL)
+    {
+        RETURN_EC_ON_FAIL(!IsEmpty(), ADSP_SIMPLE_QUEUE_EMPTY);
+        T* slot = Slot(front_);
+        if (element != NULL)
+            *element = *slot;
+        slot->~T();
+        ++front_;
+        return ADSP_SUCCESS;
+    }
+
+private:
+    CppInlineQueue(const CppInlineQueue&);
+    const CppInlineQueue& operator=(const CppInlineQueue&);
+
+    T* Slot(uint32_t index)
+    {
+        return reinterpret_cast<T*>(storage_) + (index & (SIZE - 1));
+    }
+
+    const T* Slot(uint32_t index) const
+    {
+        return reinterpret_cast<const T*>(storage_) + (index & (SIZE - 1));
+    }
+
+    // raw storage, elements exist only between push and pop
+    DCACHE_ALIGN uint8_t storage_[SIZE * sizeof(T)];
+    uint32_t rear_;
+    uint32_t front_;
+};
+
+#endif /* CPP_INLINE_QUEUE_H */
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef CPP_PRIORITY_QUEUE_H
+#define CPP_PRIORITY_QUEUE_H
+
+#include "queue.h"
+#include "cpp_backward_compatibility.h"
+
+/*!
+  \brief Multi-level priority queue of pointers, one SimpleQueue per priority level.
+  Bit n of a level mask is set while level n holds elements, so the most urgent
+  non-empty level is found with one count-leading-zeros; push and pop are O(1)
+  and elements of the same priority stay in FIFO order.
+
+  Priority LEVELS - 1 is the most urgent, 0 the least, e.g. pipeline state
+  changes are not stuck behind bulk parameter transfers.
+
+  Example:
+  \code
+      CppPriorityQueue<IpcMessage, 4, 8> ipc_queue;
+      ipc_queue.QPush(set_pipeline_state, 3);
+      ipc_queue.QPush(large_config, 0);
+      ipc_queue.QPop(&message);   // set_pipeline_state
+  \endcode
+*/
+template<typename T, uint32_t LEVELS, size_t SIZE>
+class CppPriorityQueue
+{
+    static_assert(LEVELS > 0 && LEVELS <= 32, "level mask is 32-bit");
+
+public:
+    CppPriorityQueue()
+    {
+        ResetQueue();
+    }
+
+    void ResetQueue()
+    {
+        for (uint32_t level = 0; level < LEVELS; ++level)
+            QueueInit(&queues_[level], buffers_[level], SIZE);
+        non_empty_levels_ = 0;
+    }
+
+    /*!
+      \brief Push element at given priority.
+      \return ADSP_ERROR_INVALID_PARAM when priority is not below LEVELS
+      \return ADSP_SIMPLE_QUEUE_FULL when the level is full
+    */
+    ErrorCode QPush(const T* element, uint32_t priority)
+    {
+        RETURN_EC_ON_FAIL(priority < LEVELS, ADSP_ERROR_INVALID_PARAM);
+        const ErrorCode ec = Push(&queues_[priority], element);
+        if (ec == ADSP_SUCCESS)
+            non_empty_levels_ |= 1U << priority;
+        return ec;
+    }
+
+    /*!
+      \brief Retrieve the oldest element of the most urgent non-empty level.
+      \param priority <out> level of retrieved element, can be NULL
+    */
+    ErrorCode QPop(T** element, uint32_t* priority = NULL)
+    {
+        RETURN_EC_ON_FAIL(non_empty_levels_ != 0, ADSP_SIMPLE_QUEUE_EMPTY);
+        const uint32_t level = TopLevel();
+        SimpleQueue* queue = &queues_[level];
+        const ErrorCode ec = Pop(queue, (const void **)element);
+        if (IsFree(queue))
+            non_empty_levels_ &= ~(1U << level);
+        if (priority != NULL)
+            *priority = level;
+        return ec;
+    }
+
+    ErrorCode QPeek(T** element, uint32_t* priority = NULL) const
+    {
+        RETURN_EC_ON_FAIL(non_empty_levels_ != 0, ADSP_SIMPLE_QUEUE_EMPTY);
+        const uint32_t level = TopLevel();
+        if (priority != NULL)
+            *priority = level;
+        return Peek(&queues_[level], (const void **)element);
+    }
+
+    /*!
+      \brief Remove element regardless of its position, see RemoveLazy().
+    */
+    ErrorCode QRemove(const T* element, uint32_t priority)
+    {
+        RETURN_EC_ON_FAIL(priority < LEVELS, ADSP_ERROR_INVALID_PARAM);
+        const ErrorCode ec = RemoveLazy(&queues_[priority], element);
+        if (IsFree(&queues_[priority]))
+            non_empty_levels_ &= ~(1U << priority);
+        return ec;
+    }
+
+    bool IsEmpty(void) const { return non_empty_levels_ == 0; }
+
+    uint32_t GetElementsCount(uint32_t priority) const
+    {
+        return priority < LEVELS ? ::GetElementsCount(&queues_[priority]) : 0;
+    }
+
+private:
+    uint32_t TopLevel() const
+    {
+        return 31 - __builtin_clz(non_empty_levels_);
+    }
+
+    SimpleQueue queues_[LEVELS];
+    const void* buffers_[LEVELS][SIZE];
+    // bit n set while queues_[n] holds elements
+    uint32_t non_empty_levels_;
+};
+
+#endif /* CPP_PRIORITY_QUEUE_H */
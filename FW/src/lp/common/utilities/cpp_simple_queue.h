@@ -23,6 +23,9 @@ public:
 
     ErrorCode QPush(const T* element) { return Push(this->GetQueue(), element); }
     ErrorCode QPop(T** element) { return Pop(this->GetQueue(), (const void **)element); }
+    uint32_t QPushN(T* const* elements, uint32_t count) { return PushN(this->GetQueue(), (const void* const*)elements, count); }
+    uint32_t QPopN(T** elements, uint32_t count) { return PopN(this->GetQueue(), (const void **)elements, count); }
+    uint32_t QPeekN(T** elements, uint32_t count) { return PeekN(this->GetQueue(), (const void **)elements, count); }
     bool IsEmpty(void) { return this->queue.elements_count == 0; }
     T* GetFreeElement(bool force = false) {
         T* result = NULL;
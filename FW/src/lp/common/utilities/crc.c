@@ -6,36 +6,196 @@
 #include <adsp_s_memory.h>
 #include "crc.h"
 
-static const uint8_t crc_lookup_table[] = {
-0x0, 0x4d, 0x9a, 0xd7, 0x79, 0x34, 0xe3, 0xae, 0xf2, 0xbf, 0x68, 0x25, 0x8b, 0xc6, 0x11,
-0x5c, 0xa9, 0xe4, 0x33, 0x7e, 0xd0, 0x9d, 0x4a, 0x7, 0x5b, 0x16, 0xc1, 0x8c, 0x22, 0x6f,
-0xb8, 0xf5, 0x1f, 0x52, 0x85, 0xc8, 0x66, 0x2b, 0xfc, 0xb1, 0xed, 0xa0, 0x77, 0x3a, 0x94,
-0xd9, 0xe, 0x43, 0xb6, 0xfb, 0x2c, 0x61, 0xcf, 0x82, 0x55, 0x18, 0x44, 0x9, 0xde, 0x93,
-0x3d, 0x70, 0xa7, 0xea, 0x3e, 0x73, 0xa4, 0xe9, 0x47, 0xa, 0xdd, 0x90, 0xcc, 0x81, 0x56,
-0x1b, 0xb5, 0xf8, 0x2f, 0x62, 0x97, 0xda, 0xd, 0x40, 0xee, 0xa3, 0x74, 0x39, 0x65, 0x28,
-0xff, 0xb2, 0x1c, 0x51, 0x86, 0xcb, 0x21, 0x6c, 0xbb, 0xf6, 0x58, 0x15, 0xc2, 0x8f, 0xd3,
-0x9e, 0x49, 0x4, 0xaa, 0xe7, 0x30, 0x7d, 0x88, 0xc5, 0x12, 0x5f, 0xf1, 0xbc, 0x6b, 0x26,
-0x7a, 0x37, 0xe0, 0xad, 0x3, 0x4e, 0x99, 0xd4, 0x7c, 0x31, 0xe6, 0xab, 0x5, 0x48, 0x9f,
-0xd2, 0x8e, 0xc3, 0x14, 0x59, 0xf7, 0xba, 0x6d, 0x20, 0xd5, 0x98, 0x4f, 0x2, 0xac, 0xe1,
-0x36, 0x7b, 0x27, 0x6a, 0xbd, 0xf0, 0x5e, 0x13, 0xc4, 0x89, 0x63, 0x2e, 0xf9, 0xb4, 0x1a,
-0x57, 0x80, 0xcd, 0x91, 0xdc, 0xb, 0x46, 0xe8, 0xa5, 0x72, 0x3f, 0xca, 0x87, 0x50, 0x1d,
-0xb3, 0xfe, 0x29, 0x64, 0x38, 0x75, 0xa2, 0xef, 0x41, 0xc, 0xdb, 0x96, 0x42, 0xf, 0xd8,
-0x95, 0x3b, 0x76, 0xa1, 0xec, 0xb0, 0xfd, 0x2a, 0x67, 0xc9, 0x84, 0x53, 0x1e, 0xeb, 0xa6,
-0x71, 0x3c, 0x92, 0xdf, 0x8, 0x45, 0x19, 0x54, 0x83, 0xce, 0x60, 0x2d, 0xfa, 0xb7, 0x5d,
-0x10, 0xc7, 0x8a, 0x24, 0x69, 0xbe, 0xf3, 0xaf, 0xe2, 0x35, 0x78, 0xd6, 0x9b, 0x4c, 0x1,
-0xf4, 0xb9, 0x6e, 0x23, 0x8d, 0xc0, 0x17, 0x5a, 0x6, 0x4b, 0x9c, 0xd1, 0x7f, 0x32, 0xe5,
-0xa8};
+#define CRC8_SLICES 8
 
-uint8_t CalculateCRC(uint8_t const* data, uint32_t data_len)
+/*
+ * CRC-8, polynomial 0x4D, MSB first, initial value 0xFF, no final xor.
+ * crc_slice_table[0] is the byte-wise table, crc_slice_table[k][x] is the CRC
+ * of byte x followed by k zero bytes, so 8 bytes fold into the CRC with
+ * 8 independent lookups (slicing-by-8).
+ */
+static const uint8_t crc_slice_table[CRC8_SLICES][256] = {
+    {
+        0x00, 0x4d, 0x9a, 0xd7, 0x79, 0x34, 0xe3, 0xae, 0xf2, 0xbf, 0x68, 0x25, 0x8b, 0xc6, 0x11, 0x5c,
+        0xa9, 0xe4, 0x33, 0x7e, 0xd0, 0x9d, 0x4a, 0x07, 0x5b, 0x16, 0xc1, 0x8c, 0x22, 0x6f, 0xb8, 0xf5,
+        0x1f, 0x52, 0x85, 0xc8, 0x66, 0x2b, 0xfc, 0xb1, 0xed, 0xa0, 0x77, 0x3a, 0x94, 0xd9, 0x0e, 0x43,
+        0xb6, 0xfb, 0x2c, 0x61, 0xcf, 0x82, 0x55, 0x18, 0x44, 0x09, 0xde, 0x93, 0x3d, 0x70, 0xa7, 0xea,
+        0x3e, 0x73, 0xa4, 0xe9, 0x47, 0x0a, 0xdd, 0x90, 0xcc, 0x81, 0x56, 0x1b, 0xb5, 0xf8, 0x2f, 0x62,
+        0x97, 0xda, 0x0d, 0x40, 0xee, 0xa3, 0x74, 0x39, 0x65, 0x28, 0xff, 0xb2, 0x1c, 0x51, 0x86, 0xcb,
+        0x21, 0x6c, 0xbb, 0xf6, 0x58, 0x15, 0xc2, 0x8f, 0xd3, 0x9e, 0x49, 0x04, 0xaa, 0xe7, 0x30, 0x7d,
+        0x88, 0xc5, 0x12, 0x5f, 0xf1, 0xbc, 0x6b, 0x26, 0x7a, 0x37, 0xe0, 0xad, 0x03, 0x4e, 0x99, 0xd4,
+        0x7c, 0x31, 0xe6, 0xab, 0x05, 0x48, 0x9f, 0xd2, 0x8e, 0xc3, 0x14, 0x59, 0xf7, 0xba, 0x6d, 0x20,
+        0xd5, 0x98, 0x4f, 0x02, 0xac, 0xe1, 0x36, 0x7b, 0x27, 0x6a, 0xbd, 0xf0, 0x5e, 0x13, 0xc4, 0x89,
+        0x63, 0x2e, 0xf9, 0xb4, 0x1a, 0x57, 0x80, 0xcd, 0x91, 0xdc, 0x0b, 0x46, 0xe8, 0xa5, 0x72, 0x3f,
+        0xca, 0x87, 0x50, 0x1d, 0xb3, 0xfe, 0x29, 0x64, 0x38, 0x75, 0xa2, 0xef, 0x41, 0x0c, 0xdb, 0x96,
+        0x42, 0x0f, 0xd8, 0x95, 0x3b, 0x76, 0xa1, 0xec, 0xb0, 0xfd, 0x2a, 0x67, 0xc9, 0x84, 0x53, 0x1e,
+        0xeb, 0xa6, 0x71, 0x3c, 0x92, 0xdf, 0x08, 0x45, 0x19, 0x54, 0x83, 0xce, 0x60, 0x2d, 0xfa, 0xb7,
+        0x5d, 0x10, 0xc7, 0x8a, 0x24, 0x69, 0xbe, 0xf3, 0xaf, 0xe2, 0x35, 0x78, 0xd6, 0x9b, 0x4c, 0x01,
+        0xf4, 0xb9, 0x6e, 0x23, 0x8d, 0xc0, 0x17, 0x5a, 0x06, 0x4b, 0x9c, 0xd1, 0x7f, 0x32, 0xe5, 0xa8
+    },
+    {
+        0x00, 0xf8, 0xbd, 0x45, 0x37, 0xcf, 0x8a, 0x72, 0x6e, 0x96, 0xd3, 0x2b, 0x59, 0xa1, 0xe4, 0x1c,
+        0xdc, 0x24, 0x61, 0x99, 0xeb, 0x13, 0x56, 0xae, 0xb2, 0x4a, 0x0f, 0xf7, 0x85, 0x7d, 0x38, 0xc0,
+        0xf5, 0x0d, 0x48, 0xb0, 0xc2, 0x3a, 0x7f, 0x87, 0x9b, 0x63, 0x26, 0xde, 0xac, 0x54, 0x11, 0xe9,
+        0x29, 0xd1, 0x94, 0x6c, 0x1e, 0xe6, 0xa3, 0x5b, 0x47, 0xbf, 0xfa, 0x02, 0x70, 0x88, 0xcd, 0x35,
+        0xa7, 0x5f, 0x1a, 0xe2, 0x90, 0x68, 0x2d, 0xd5, 0xc9, 0x31, 0x74, 0x8c, 0xfe, 0x06, 0x43, 0xbb,
+        0x7b, 0x83, 0xc6, 0x3e, 0x4c, 0xb4, 0xf1, 0x09, 0x15, 0xed, 0xa8, 0x50, 0x22, 0xda, 0x9f, 0x67,
+        0x52, 0xaa, 0xef, 0x17, 0x65, 0x9d, 0xd8, 0x20, 0x3c, 0xc4, 0x81, 0x79, 0x0b, 0xf3, 0xb6, 0x4e,
+        0x8e, 0x76, 0x33, 0xcb, 0xb9, 0x41, 0x04, 0xfc, 0xe0, 0x18, 0x5d, 0xa5, 0xd7, 0x2f, 0x6a, 0x92,
+        0x03, 0xfb, 0xbe, 0x46, 0x34, 0xcc, 0x89, 0x71, 0x6d, 0x95, 0xd0, 0x28, 0x5a, 0xa2, 0xe7, 0x1f,
+        0xdf, 0x27, 0x62, 0x9a, 0xe8, 0x10, 0x55, 0xad, 0xb1, 0x49, 0x0c, 0xf4, 0x86, 0x7e, 0x3b, 0xc3,
+        0xf6, 0x0e, 0x4b, 0xb3, 0xc1, 0x39, 0x7c, 0x84, 0x98, 0x60, 0x25, 0xdd, 0xaf, 0x57, 0x12, 0xea,
+        0x2a, 0xd2, 0x97, 0x6f, 0x1d, 0xe5, 0xa0, 0x58, 0x44, 0xbc, 0xf9, 0x01, 0x73, 0x8b, 0xce, 0x36,
+        0xa4, 0x5c, 0x19, 0xe1, 0x93, 0x6b, 0x2e, 0xd6, 0xca, 0x32, 0x77, 0x8f, 0xfd, 0x05, 0x40, 0xb8,
+        0x78, 0x80, 0xc5, 0x3d, 0x4f, 0xb7, 0xf2, 0x0a, 0x16, 0xee, 0xab, 0x53, 0x21, 0xd9, 0x9c, 0x64,
+        0x51, 0xa9, 0xec, 0x14, 0x66, 0x9e, 0xdb, 0x23, 0x3f, 0xc7, 0x82, 0x7a, 0x08, 0xf0, 0xb5, 0x4d,
+        0x8d, 0x75, 0x30, 0xc8, 0xba, 0x42, 0x07, 0xff, 0xe3, 0x1b, 0x5e, 0xa6, 0xd4, 0x2c, 0x69, 0x91
+    },
+    {
+        0x00, 0x06, 0x0c, 0x0a, 0x18, 0x1e, 0x14, 0x12, 0x30, 0x36, 0x3c, 0x3a, 0x28, 0x2e, 0x24, 0x22,
+        0x60, 0x66, 0x6c, 0x6a, 0x78, 0x7e, 0x74, 0x72, 0x50, 0x56, 0x5c, 0x5a, 0x48, 0x4e, 0x44, 0x42,
+        0xc0, 0xc6, 0xcc, 0xca, 0xd8, 0xde, 0xd4, 0xd2, 0xf0, 0xf6, 0xfc, 0xfa, 0xe8, 0xee, 0xe4, 0xe2,
+        0xa0, 0xa6, 0xac, 0xaa, 0xb8, 0xbe, 0xb4, 0xb2, 0x90, 0x96, 0x9c, 0x9a, 0x88, 0x8e, 0x84, 0x82,
+        0xcd, 0xcb, 0xc1, 0xc7, 0xd5, 0xd3, 0xd9, 0xdf, 0xfd, 0xfb, 0xf1, 0xf7, 0xe5, 0xe3, 0xe9, 0xef,
+        0xad, 0xab, 0xa1, 0xa7, 0xb5, 0xb3, 0xb9, 0xbf, 0x9d, 0x9b, 0x91, 0x97, 0x85, 0x83, 0x89, 0x8f,
+        0x0d, 0x0b, 0x01, 0x07, 0x15, 0x13, 0x19, 0x1f, 0x3d, 0x3b, 0x31, 0x37, 0x25, 0x23, 0x29, 0x2f,
+        0x6d, 0x6b, 0x61, 0x67, 0x75, 0x73, 0x79, 0x7f, 0x5d, 0x5b, 0x51, 0x57, 0x45, 0x43, 0x49, 0x4f,
+        0xd7, 0xd1, 0xdb, 0xdd, 0xcf, 0xc9, 0xc3, 0xc5, 0xe7, 0xe1, 0xeb, 0xed, 0xff, 0xf9, 0xf3, 0xf5,
+        0xb7, 0xb1, 0xbb, 0xbd, 0xaf, 0xa9, 0xa3, 0xa5, 0x87, 0x81, 0x8b, 0x8d, 0x9f, 0x99, 0x93, 0x95,
+        0x17, 0x11, 0x1b, 0x1d, 0x0f, 0x09, 0x03, 0x05, 0x27, 0x21, 0x2b, 0x2d, 0x3f, 0x39, 0x33, 0x35,
+        0x77, 0x71, 0x7b, 0x7d, 0x6f, 0x69, 0x63, 0x65, 0x47, 0x41, 0x4b, 0x4d, 0x5f, 0x59, 0x53, 0x55,
+        0x1a, 0x1c, 0x16, 0x10, 0x02, 0x04, 0x0e, 0x08, 0x2a, 0x2c, 0x26, 0x20, 0x32, 0x34, 0x3e, 0x38,
+        0x7a, 0x7c, 0x76, 0x70, 0x62, 0x64, 0x6e, 0x68, 0x4a, 0x4c, 0x46, 0x40, 0x52, 0x54, 0x5e, 0x58,
+        0xda, 0xdc, 0xd6, 0xd0, 0xc2, 0xc4, 0xce, 0xc8, 0xea, 0xec, 0xe6, 0xe0, 0xf2, 0xf4, 0xfe, 0xf8,
+        0xba, 0xbc, 0xb6, 0xb0, 0xa2, 0xa4, 0xae, 0xa8, 0x8a, 0x8c, 0x86, 0x80, 0x92, 0x94, 0x9e, 0x98
+    },
+    {
+        0x00, 0xe3, 0x8b, 0x68, 0x5b, 0xb8, 0xd0, 0x33, 0xb6, 0x55, 0x3d, 0xde, 0xed, 0x0e, 0x66, 0x85,
+        0x21, 0xc2, 0xaa, 0x49, 0x7a, 0x99, 0xf1, 0x12, 0x97, 0x74, 0x1c, 0xff, 0xcc, 0x2f, 0x47, 0xa4,
+        0x42, 0xa1, 0xc9, 0x2a, 0x19, 0xfa, 0x92, 0x71, 0xf4, 0x17, 0x7f, 0x9c, 0xaf, 0x4c, 0x24, 0xc7,
+        0x63, 0x80, 0xe8, 0x0b, 0x38, 0xdb, 0xb3, 0x50, 0xd5, 0x36, 0x5e, 0xbd, 0x8e, 0x6d, 0x05, 0xe6,
+        0x84, 0x67, 0x0f, 0xec, 0xdf, 0x3c, 0x54, 0xb7, 0x32, 0xd1, 0xb9, 0x5a, 0x69, 0x8a, 0xe2, 0x01,
+        0xa5, 0x46, 0x2e, 0xcd, 0xfe, 0x1d, 0x75, 0x96, 0x13, 0xf0, 0x98, 0x7b, 0x48, 0xab, 0xc3, 0x20,
+        0xc6, 0x25, 0x4d, 0xae, 0x9d, 0x7e, 0x16, 0xf5, 0x70, 0x93, 0xfb, 0x18, 0x2b, 0xc8, 0xa0, 0x43,
+        0xe7, 0x04, 0x6c, 0x8f, 0xbc, 0x5f, 0x37, 0xd4, 0x51, 0xb2, 0xda, 0x39, 0x0a, 0xe9, 0x81, 0x62,
+        0x45, 0xa6, 0xce, 0x2d, 0x1e, 0xfd, 0x95, 0x76, 0xf3, 0x10, 0x78, 0x9b, 0xa8, 0x4b, 0x23, 0xc0,
+        0x64, 0x87, 0xef, 0x0c, 0x3f, 0xdc, 0xb4, 0x57, 0xd2, 0x31, 0x59, 0xba, 0x89, 0x6a, 0x02, 0xe1,
+        0x07, 0xe4, 0x8c, 0x6f, 0x5c, 0xbf, 0xd7, 0x34, 0xb1, 0x52, 0x3a, 0xd9, 0xea, 0x09, 0x61, 0x82,
+        0x26, 0xc5, 0xad, 0x4e, 0x7d, 0x9e, 0xf6, 0x15, 0x90, 0x73, 0x1b, 0xf8, 0xcb, 0x28, 0x40, 0xa3,
+        0xc1, 0x22, 0x4a, 0xa9, 0x9a, 0x79, 0x11, 0xf2, 0x77, 0x94, 0xfc, 0x1f, 0x2c, 0xcf, 0xa7, 0x44,
+        0xe0, 0x03, 0x6b, 0x88, 0xbb, 0x58, 0x30, 0xd3, 0x56, 0xb5, 0xdd, 0x3e, 0x0d, 0xee, 0x86, 0x65,
+        0x83, 0x60, 0x08, 0xeb, 0xd8, 0x3b, 0x53, 0xb0, 0x35, 0xd6, 0xbe, 0x5d, 0x6e, 0x8d, 0xe5, 0x06,
+        0xa2, 0x41, 0x29, 0xca, 0xf9, 0x1a, 0x72, 0x91, 0x14, 0xf7, 0x9f, 0x7c, 0x4f, 0xac, 0xc4, 0x27
+    },
+    {
+        0x00, 0x8a, 0x59, 0xd3, 0xb2, 0x38, 0xeb, 0x61, 0x29, 0xa3, 0x70, 0xfa, 0x9b, 0x11, 0xc2, 0x48,
+        0x52, 0xd8, 0x0b, 0x81, 0xe0, 0x6a, 0xb9, 0x33, 0x7b, 0xf1, 0x22, 0xa8, 0xc9, 0x43, 0x90, 0x1a,
+        0xa4, 0x2e, 0xfd, 0x77, 0x16, 0x9c, 0x4f, 0xc5, 0x8d, 0x07, 0xd4, 0x5e, 0x3f, 0xb5, 0x66, 0xec,
+        0xf6, 0x7c, 0xaf, 0x25, 0x44, 0xce, 0x1d, 0x97, 0xdf, 0x55, 0x86, 0x0c, 0x6d, 0xe7, 0x34, 0xbe,
+        0x05, 0x8f, 0x5c, 0xd6, 0xb7, 0x3d, 0xee, 0x64, 0x2c, 0xa6, 0x75, 0xff, 0x9e, 0x14, 0xc7, 0x4d,
+        0x57, 0xdd, 0x0e, 0x84, 0xe5, 0x6f, 0xbc, 0x36, 0x7e, 0xf4, 0x27, 0xad, 0xcc, 0x46, 0x95, 0x1f,
+        0xa1, 0x2b, 0xf8, 0x72, 0x13, 0x99, 0x4a, 0xc0, 0x88, 0x02, 0xd1, 0x5b, 0x3a, 0xb0, 0x63, 0xe9,
+        0xf3, 0x79, 0xaa, 0x20, 0x41, 0xcb, 0x18, 0x92, 0xda, 0x50, 0x83, 0x09, 0x68, 0xe2, 0x31, 0xbb,
+        0x0a, 0x80, 0x53, 0xd9, 0xb8, 0x32, 0xe1, 0x6b, 0x23, 0xa9, 0x7a, 0xf0, 0x91, 0x1b, 0xc8, 0x42,
+        0x58, 0xd2, 0x01, 0x8b, 0xea, 0x60, 0xb3, 0x39, 0x71, 0xfb, 0x28, 0xa2, 0xc3, 0x49, 0x9a, 0x10,
+        0xae, 0x24, 0xf7, 0x7d, 0x1c, 0x96, 0x45, 0xcf, 0x87, 0x0d, 0xde, 0x54, 0x35, 0xbf, 0x6c, 0xe6,
+        0xfc, 0x76, 0xa5, 0x2f, 0x4e, 0xc4, 0x17, 0x9d, 0xd5, 0x5f, 0x8c, 0x06, 0x67, 0xed, 0x3e, 0xb4,
+        0x0f, 0x85, 0x56, 0xdc, 0xbd, 0x37, 0xe4, 0x6e, 0x26, 0xac, 0x7f, 0xf5, 0x94, 0x1e, 0xcd, 0x47,
+        0x5d, 0xd7, 0x04, 0x8e, 0xef, 0x65, 0xb6, 0x3c, 0x74, 0xfe, 0x2d, 0xa7, 0xc6, 0x4c, 0x9f, 0x15,
+        0xab, 0x21, 0xf2, 0x78, 0x19, 0x93, 0x40, 0xca, 0x82, 0x08, 0xdb, 0x51, 0x30, 0xba, 0x69, 0xe3,
+        0xf9, 0x73, 0xa0, 0x2a, 0x4b, 0xc1, 0x12, 0x98, 0xd0, 0x5a, 0x89, 0x03, 0x62, 0xe8, 0x3b, 0xb1
+    },
+    {
+        0x00, 0x14, 0x28, 0x3c, 0x50, 0x44, 0x78, 0x6c, 0xa0, 0xb4, 0x88, 0x9c, 0xf0, 0xe4, 0xd8, 0xcc,
+        0x0d, 0x19, 0x25, 0x31, 0x5d, 0x49, 0x75, 0x61, 0xad, 0xb9, 0x85, 0x91, 0xfd, 0xe9, 0xd5, 0xc1,
+        0x1a, 0x0e, 0x32, 0x26, 0x4a, 0x5e, 0x62, 0x76, 0xba, 0xae, 0x92, 0x86, 0xea, 0xfe, 0xc2, 0xd6,
+        0x17, 0x03, 0x3f, 0x2b, 0x47, 0x53, 0x6f, 0x7b, 0xb7, 0xa3, 0x9f, 0x8b, 0xe7, 0xf3, 0xcf, 0xdb,
+        0x34, 0x20, 0x1c, 0x08, 0x64, 0x70, 0x4c, 0x58, 0x94, 0x80, 0xbc, 0xa8, 0xc4, 0xd0, 0xec, 0xf8,
+        0x39, 0x2d, 0x11, 0x05, 0x69, 0x7d, 0x41, 0x55, 0x99, 0x8d, 0xb1, 0xa5, 0xc9, 0xdd, 0xe1, 0xf5,
+        0x2e, 0x3a, 0x06, 0x12, 0x7e, 0x6a, 0x56, 0x42, 0x8e, 0x9a, 0xa6, 0xb2, 0xde, 0xca, 0xf6, 0xe2,
+        0x23, 0x37, 0x0b, 0x1f, 0x73, 0x67, 0x5b, 0x4f, 0x83, 0x97, 0xab, 0xbf, 0xd3, 0xc7, 0xfb, 0xef,
+        0x68, 0x7c, 0x40, 0x54, 0x38, 0x2c, 0x10, 0x04, 0xc8, 0xdc, 0xe0, 0xf4, 0x98, 0x8c, 0xb0, 0xa4,
+        0x65, 0x71, 0x4d, 0x59, 0x35, 0x21, 0x1d, 0x09, 0xc5, 0xd1, 0xed, 0xf9, 0x95, 0x81, 0xbd, 0xa9,
+        0x72, 0x66, 0x5a, 0x4e, 0x22, 0x36, 0x0a, 0x1e, 0xd2, 0xc6, 0xfa, 0xee, 0x82, 0x96, 0xaa, 0xbe,
+        0x7f, 0x6b, 0x57, 0x43, 0x2f, 0x3b, 0x07, 0x13, 0xdf, 0xcb, 0xf7, 0xe3, 0x8f, 0x9b, 0xa7, 0xb3,
+        0x5c, 0x48, 0x74, 0x60, 0x0c, 0x18, 0x24, 0x30, 0xfc, 0xe8, 0xd4, 0xc0, 0xac, 0xb8, 0x84, 0x90,
+        0x51, 0x45, 0x79, 0x6d, 0x01, 0x15, 0x29, 0x3d, 0xf1, 0xe5, 0xd9, 0xcd, 0xa1, 0xb5, 0x89, 0x9d,
+        0x46, 0x52, 0x6e, 0x7a, 0x16, 0x02, 0x3e, 0x2a, 0xe6, 0xf2, 0xce, 0xda, 0xb6, 0xa2, 0x9e, 0x8a,
+        0x4b, 0x5f, 0x63, 0x77, 0x1b, 0x0f, 0x33, 0x27, 0xeb, 0xff, 0xc3, 0xd7, 0xbb, 0xaf, 0x93, 0x87
+    },
+    {
+        0x00, 0xd0, 0xed, 0x3d, 0x97, 0x47, 0x7a, 0xaa, 0x63, 0xb3, 0x8e, 0x5e, 0xf4, 0x24, 0x19, 0xc9,
+        0xc6, 0x16, 0x2b, 0xfb, 0x51, 0x81, 0xbc, 0x6c, 0xa5, 0x75, 0x48, 0x98, 0x32, 0xe2, 0xdf, 0x0f,
+        0xc1, 0x11, 0x2c, 0xfc, 0x56, 0x86, 0xbb, 0x6b, 0xa2, 0x72, 0x4f, 0x9f, 0x35, 0xe5, 0xd8, 0x08,
+        0x07, 0xd7, 0xea, 0x3a, 0x90, 0x40, 0x7d, 0xad, 0x64, 0xb4, 0x89, 0x59, 0xf3, 0x23, 0x1e, 0xce,
+        0xcf, 0x1f, 0x22, 0xf2, 0x58, 0x88, 0xb5, 0x65, 0xac, 0x7c, 0x41, 0x91, 0x3b, 0xeb, 0xd6, 0x06,
+        0x09, 0xd9, 0xe4, 0x34, 0x9e, 0x4e, 0x73, 0xa3, 0x6a, 0xba, 0x87, 0x57, 0xfd, 0x2d, 0x10, 0xc0,
+        0x0e, 0xde, 0xe3, 0x33, 0x99, 0x49, 0x74, 0xa4, 0x6d, 0xbd, 0x80, 0x50, 0xfa, 0x2a, 0x17, 0xc7,
+        0xc8, 0x18, 0x25, 0xf5, 0x5f, 0x8f, 0xb2, 0x62, 0xab, 0x7b, 0x46, 0x96, 0x3c, 0xec, 0xd1, 0x01,
+        0xd3, 0x03, 0x3e, 0xee, 0x44, 0x94, 0xa9, 0x79, 0xb0, 0x60, 0x5d, 0x8d, 0x27, 0xf7, 0xca, 0x1a,
+        0x15, 0xc5, 0xf8, 0x28, 0x82, 0x52, 0x6f, 0xbf, 0x76, 0xa6, 0x9b, 0x4b, 0xe1, 0x31, 0x0c, 0xdc,
+        0x12, 0xc2, 0xff, 0x2f, 0x85, 0x55, 0x68, 0xb8, 0x71, 0xa1, 0x9c, 0x4c, 0xe6, 0x36, 0x0b, 0xdb,
+        0xd4, 0x04, 0x39, 0xe9, 0x43, 0x93, 0xae, 0x7e, 0xb7, 0x67, 0x5a, 0x8a, 0x20, 0xf0, 0xcd, 0x1d,
+        0x1c, 0xcc, 0xf1, 0x21, 0x8b, 0x5b, 0x66, 0xb6, 0x7f, 0xaf, 0x92, 0x42, 0xe8, 0x38, 0x05, 0xd5,
+        0xda, 0x0a, 0x37, 0xe7, 0x4d, 0x9d, 0xa0, 0x70, 0xb9, 0x69, 0x54, 0x84, 0x2e, 0xfe, 0xc3, 0x13,
+        0xdd, 0x0d, 0x30, 0xe0, 0x4a, 0x9a, 0xa7, 0x77, 0xbe, 0x6e, 0x53, 0x83, 0x29, 0xf9, 0xc4, 0x14,
+        0x1b, 0xcb, 0xf6, 0x26, 0x8c, 0x5c, 0x61, 0xb1, 0x78, 0xa8, 0x95, 0x45, 0xef, 0x3f, 0x02, 0xd2
+    },
+    {
+        0x00, 0xeb, 0x9b, 0x70, 0x7b, 0x90, 0xe0, 0x0b, 0xf6, 0x1d, 0x6d, 0x86, 0x8d, 0x66, 0x16, 0xfd,
+        0xa1, 0x4a, 0x3a, 0xd1, 0xda, 0x31, 0x41, 0xaa, 0x57, 0xbc, 0xcc, 0x27, 0x2c, 0xc7, 0xb7, 0x5c,
+        0x0f, 0xe4, 0x94, 0x7f, 0x74, 0x9f, 0xef, 0x04, 0xf9, 0x12, 0x62, 0x89, 0x82, 0x69, 0x19, 0xf2,
+        0xae, 0x45, 0x35, 0xde, 0xd5, 0x3e, 0x4e, 0xa5, 0x58, 0xb3, 0xc3, 0x28, 0x23, 0xc8, 0xb8, 0x53,
+        0x1e, 0xf5, 0x85, 0x6e, 0x65, 0x8e, 0xfe, 0x15, 0xe8, 0x03, 0x73, 0x98, 0x93, 0x78, 0x08, 0xe3,
+        0xbf, 0x54, 0x24, 0xcf, 0xc4, 0x2f, 0x5f, 0xb4, 0x49, 0xa2, 0xd2, 0x39, 0x32, 0xd9, 0xa9, 0x42,
+        0x11, 0xfa, 0x8a, 0x61, 0x6a, 0x81, 0xf1, 0x1a, 0xe7, 0x0c, 0x7c, 0x97, 0x9c, 0x77, 0x07, 0xec,
+        0xb0, 0x5b, 0x2b, 0xc0, 0xcb, 0x20, 0x50, 0xbb, 0x46, 0xad, 0xdd, 0x36, 0x3d, 0xd6, 0xa6, 0x4d,
+        0x3c, 0xd7, 0xa7, 0x4c, 0x47, 0xac, 0xdc, 0x37, 0xca, 0x21, 0x51, 0xba, 0xb1, 0x5a, 0x2a, 0xc1,
+        0x9d, 0x76, 0x06, 0xed, 0xe6, 0x0d, 0x7d, 0x96, 0x6b, 0x80, 0xf0, 0x1b, 0x10, 0xfb, 0x8b, 0x60,
+        0x33, 0xd8, 0xa8, 0x43, 0x48, 0xa3, 0xd3, 0x38, 0xc5, 0x2e, 0x5e, 0xb5, 0xbe, 0x55, 0x25, 0xce,
+        0x92, 0x79, 0x09, 0xe2, 0xe9, 0x02, 0x72, 0x99, 0x64, 0x8f, 0xff, 0x14, 0x1f, 0xf4, 0x84, 0x6f,
+        0x22, 0xc9, 0xb9, 0x52, 0x59, 0xb2, 0xc2, 0x29, 0xd4, 0x3f, 0x4f, 0xa4, 0xaf, 0x44, 0x34, 0xdf,
+        0x83, 0x68, 0x18, 0xf3, 0xf8, 0x13, 0x63, 0x88, 0x75, 0x9e, 0xee, 0x05, 0x0e, 0xe5, 0x95, 0x7e,
+        0x2d, 0xc6, 0xb6, 0x5d, 0x56, 0xbd, 0xcd, 0x26, 0xdb, 0x30, 0x40, 0xab, 0xa0, 0x4b, 0x3b, 0xd0,
+        0x8c, 0x67, 0x17, 0xfc, 0xf7, 0x1c, 0x6c, 0x87, 0x7a, 0x91, 0xe1, 0x0a, 0x01, 0xea, 0x9a, 0x71
+    }
+};
+
+uint8_t Crc8Init(void)
 {
-    assert(data != NULL);
-    assert(data_len < sizeof(crc_lookup_table));
-    uint8_t crc = 0xFF;
-    uint8_t index = 0;
-    for (size_t i = 0; i < data_len; i++)
+    return 0xFF;
+}
+
+uint8_t Crc8Update(uint8_t crc, uint8_t const* data, uint32_t data_len)
+{
+    assert(data != NULL || data_len == 0);
+    while (data_len >= CRC8_SLICES)
+    {
+        crc = crc_slice_table[7][data[0] ^ crc] ^
+              crc_slice_table[6][data[1]] ^
+              crc_slice_table[5][data[2]] ^
+              crc_slice_table[4][data[3]] ^
+              crc_slice_table[3][data[4]] ^
+              crc_slice_table[2][data[5]] ^
+              crc_slice_table[1][data[6]] ^
+              crc_slice_table[0][data[7]];
+        data += CRC8_SLICES;
+        data_len -= CRC8_SLICES;
+    }
+    for (uint32_t i = 0; i < data_len; i++)
     {
-        index = data[i] ^ crc;
-        crc = crc_lookup_table[index];
+        crc = crc_slice_table[0][data[i] ^ crc];
     }
     return crc;
 }
+
+uint8_t Crc8Finalize(uint8_t crc)
+{
+    return crc;
+}
+
+uint8_t CalculateCRC(uint8_t const* data, uint32_t data_len)
+{
+    assert(data != NULL);
+    return Crc8Finalize(Crc8Update(Crc8Init(), data, data_len));
+}
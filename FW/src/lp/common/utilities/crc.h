@@ -8,8 +8,19 @@
 
 EXTERN_C_BEGIN
 
+/*!
+  \brief Calculates CRC-8 (polynomial 0x4D, initial value 0xFF) of data of any length.
+*/
 uint8_t CalculateCRC(uint8_t const* data, uint32_t data_len);
 
+/*!
+  \brief Incremental form of CalculateCRC for data split into fragments:
+  crc = Crc8Init(); crc = Crc8Update(crc, fragment, len)...; result = Crc8Finalize(crc);
+*/
+uint8_t Crc8Init(void);
+uint8_t Crc8Update(uint8_t crc, uint8_t const* data, uint32_t data_len);
+uint8_t Crc8Finalize(uint8_t crc);
+
 EXTERN_C_END
 
 #endif // CRC_H
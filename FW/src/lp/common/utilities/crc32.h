@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef CRC32_H
+#define CRC32_H
+#include <stdint.h>
+
+EXTERN_C_BEGIN
+
+/*
+ * CRC-32 (IEEE 802.3, zlib, PNG) and CRC-32C (Castagnoli, iSCSI), both reflected,
+ * initial value and final xor 0xFFFFFFFF. CRC-32 of "123456789" is 0xCBF43926,
+ * CRC-32C of "123456789" is 0xE3069283.
+ *
+ * Data split into fragments is processed incrementally:
+ *   crc = Crc32Init(); crc = Crc32Update(crc, fragment, len)...; result = Crc32Finalize(crc);
+ * Crc32Init/Crc32Finalize apply to both polynomials.
+ */
+
+uint32_t Crc32Init(void);
+uint32_t Crc32Update(uint32_t crc, uint8_t const* data, uint32_t data_len);
+uint32_t Crc32cUpdate(uint32_t crc, uint8_t const* data, uint32_t data_len);
+uint32_t Crc32Finalize(uint32_t crc);
+
+uint32_t CalculateCrc32(uint8_t const* data, uint32_t data_len);
+uint32_t CalculateCrc32c(uint8_t const* data, uint32_t data_len);
+
+EXTERN_C_END
+
+#endif // CRC32_H
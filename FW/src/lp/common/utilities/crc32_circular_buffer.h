@@ -0,0 +1,59 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  CRC-32/CRC-32C over data stored in CircularBuffer.
+*/
+
+#ifndef DSP_FW_UTILITIES_CRC32_CIRCULAR_BUFFER_H
+#define DSP_FW_UTILITIES_CRC32_CIRCULAR_BUFFER_H
+
+#include "adsp_std_defs.h"
+#include "crc32.h"
+#include "circular_buffer_template.h"
+
+namespace dsp_fw
+{
+
+/*!
+  \brief Calls update(crc, segment, segment_len) on readable data of the buffer,
+  i.e. GetDataSize() bytes starting after the data already queued for reading,
+  split in at most two segments at the wrap point. Buffer must not be read or
+  written concurrently.
+  \return updated crc, pass it to Crc32Finalize() after the last fragment.
+*/
+template <class T>
+uint32_t Crc32UpdateCircularBuffer(uint32_t (*update)(uint32_t, uint8_t const*, uint32_t),
+                                   uint32_t crc, const CircularBuffer<T>& buffer)
+{
+    const size_t data_size = buffer.GetDataSize();
+    const size_t start = (buffer.GetReadPosition() + buffer.GetReadDataQueued()) % buffer.logical_size();
+    const size_t first = min(buffer.logical_size() - start, data_size);
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(buffer.begin());
+    crc = update(crc, base + start * sizeof(T), first * sizeof(T));
+    return update(crc, base, (data_size - first) * sizeof(T));
+}
+
+/*!
+  \brief Returns CRC-32 of readable data of the buffer, see Crc32UpdateCircularBuffer().
+*/
+template <class T>
+uint32_t CalculateCrc32OfBuffer(const CircularBuffer<T>& buffer)
+{
+    return Crc32Finalize(Crc32UpdateCircularBuffer(Crc32Update, Crc32Init(), buffer));
+}
+
+/*!
+  \brief Returns CRC-32C of readable data of the buffer, see Crc32UpdateCircularBuffer().
+*/
+template <class T>
+uint32_t CalculateCrc32cOfBuffer(const CircularBuffer<T>& buffer)
+{
+    return Crc32Finalize(Crc32UpdateCircularBuffer(Crc32cUpdate, Crc32Init(), buffer));
+}
+
+} // namespace dsp_fw
+
+#endif // DSP_FW_UTILITIES_CRC32_CIRCULAR_BUFFER_H
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef _ADSP_FW_FFT_H
+#define _ADSP_FW_FFT_H
+
+#include "adsp_std_defs.h"
+#include "adsp_error.h"
+
+/*
+ * In-place FFT for power of two sizes FFT_MIN_SIZE..FFT_MAX_SIZE.
+ *
+ * Complex transforms take and return data in natural order. Real transforms take
+ * n real samples and return n / 2 + 1 bins packed into the same n values:
+ * data[0] = X[0].re, data[1] = X[n / 2].re, data[2k], data[2k + 1] = X[k] for 0 < k < n / 2
+ * (imaginary parts of X[0] and X[n / 2] are zero). Inverse real transforms take
+ * the same layout.
+ *
+ * Scaling:
+ *   float forward  X[k] = sum x[i] * e^(-2 pi j i k / n)
+ *   float inverse  x[i] = 1 / n * sum X[k] * e^(2 pi j i k / n), forward + inverse is identity
+ *   Q1.31          both directions are scaled by 1 / n (1/2 per radix-2 stage) to avoid
+ *                  overflow, forward + inverse returns x / n. Input magnitude must not exceed 1.
+ */
+
+#define FFT_MIN_SIZE 64
+#define FFT_MAX_SIZE 4096
+
+typedef struct _ComplexF32
+{
+    float re;
+    float im;
+} ComplexF32;
+
+typedef struct _ComplexQ31
+{
+    int32_t re;
+    int32_t im;
+} ComplexQ31;
+
+/*!
+  \brief Transforms n complex values in place.
+  \return ADSP_SUCCESS
+  \return ADSP_ERROR_INVALID_PARAM when n is not a power of two within FFT size limits
+*/
+ErrorCode fft_complex_f32(ComplexF32* data, uint32_t n);
+ErrorCode ifft_complex_f32(ComplexF32* data, uint32_t n);
+ErrorCode fft_complex_q31(ComplexQ31* data, uint32_t n);
+ErrorCode ifft_complex_q31(ComplexQ31* data, uint32_t n);
+
+/*!
+  \brief Transforms n real values in place into packed half spectrum (and back).
+  \return ADSP_SUCCESS
+  \return ADSP_ERROR_INVALID_PARAM when n is not a power of two within FFT size limits
+*/
+ErrorCode fft_real_f32(float* data, uint32_t n);
+ErrorCode ifft_real_f32(float* data, uint32_t n);
+ErrorCode fft_real_q31(int32_t* data, uint32_t n);
+ErrorCode ifft_real_q31(int32_t* data, uint32_t n);
+
+#endif //_ADSP_FW_FFT_H
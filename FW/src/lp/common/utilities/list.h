@@ -8,6 +8,7 @@
 #include "utilities/bitmap.h"
 #include <core/kernel/memory/memory_pool.h>
 #include "simple_mem_alloc.h"
+#include "cpp_backward_compatibility.h"
 
 namespace dsp_fw
 {
@@ -291,9 +292,250 @@ private:
 };
 
 /*!
-  \brief bi-directional list with pre allocated array
+  \brief Unidirectional list keeping up to ELEMS elements per node.
+  Walking the list touches one node (a few cache lines) per ELEMS elements
+  instead of one Item per element as UniList does. Nodes are allocated from
+  the pool on demand and, as with UniList, returned together with the pool.
+
+  Example:
+  \code
+      UnrolledList<ModuleInstance*> modules;
+      modules.PushBack(mem_pool, mi);
+      for (UnrolledList<ModuleInstance*>::Iterator it = modules.Begin(); it != modules.End(); ++it)
+          (*it)->Process();
+  \endcode
+*/
+template<class T, size_t ELEMS = 8>
+class UnrolledList
+{
+public:
+    struct Node
+    {
+        T elems[ELEMS];
+        size_t count;
+        Node* next;
+        Node() : count(0), next(NULL) {}
+    };
+
+    class Iterator
+    {
+    public:
+        Iterator(Node* node, size_t idx) : node_(node), idx_(idx) {}
+        T& operator*() const { return node_->elems[idx_]; }
+        Iterator& operator++()
+        {
+            if (++idx_ == node_->count)
+            {
+                node_ = node_->next;
+                idx_ = 0;
+            }
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return node_ == other.node_ && idx_ == other.idx_; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    private:
+        Node* node_;
+        size_t idx_;
+    };
+
+    UnrolledList() :size_(0), head_(NULL), tail_(NULL) {}
+
+    /*!
+      \brief Reset list to initial state, nodes are left to the pool.
+    */
+    void Reset()
+    {
+        size_ = 0;
+        head_ = NULL;
+        tail_ = NULL;
+    }
+
+    size_t GetSize() const { return size_; }
+
+    Iterator Begin() { return Iterator(head_, 0); }
+    Iterator End() { return Iterator(NULL, 0); }
+    Iterator begin() { return Begin(); }
+    Iterator end() { return End(); }
+
+    /*!
+      \brief Inserts a new element at the end of the list,
+      a node is allocated when the tail one is full.
+      \return ASDP_OUT_OF_RESOURCES Memory allocation failed.
+    */
+    ErrorCode PushBack(memory_pool_s* mem_pool, T elem)
+    {
+        if (NULL == tail_ || tail_->count == ELEMS)
+        {
+            Node* node = new(mem_pool) Node();
+            if (NULL == node)
+                return ADSP_OUT_OF_RESOURCES;
+            LinkBack(node);
+        }
+        tail_->elems[tail_->count++] = elem;
+        ++size_;
+        return ADSP_SUCCESS;
+    }
+
+    ErrorCode PushBack(SimpleMemAlloc* pool, T elem)
+    {
+        if (NULL == tail_ || tail_->count == ELEMS)
+        {
+            Node* node = new(pool) Node();
+            if (NULL == node)
+                return ADSP_OUT_OF_RESOURCES;
+            LinkBack(node);
+        }
+        tail_->elems[tail_->count++] = elem;
+        ++size_;
+        return ADSP_SUCCESS;
+    }
+
+    /*!
+      \brief Inserts a new element at the beginning of the list,
+      elements of the head node are shifted, a node is allocated when it is full.
+      \return ASDP_OUT_OF_RESOURCES Memory allocation failed.
+    */
+    ErrorCode PushFront(memory_pool_s* mem_pool, T elem)
+    {
+        if (NULL == head_ || head_->count == ELEMS)
+        {
+            Node* node = new(mem_pool) Node();
+            if (NULL == node)
+                return ADSP_OUT_OF_RESOURCES;
+            LinkFront(node);
+        }
+        InsertFront(elem);
+        return ADSP_SUCCESS;
+    }
+
+    ErrorCode PushFront(SimpleMemAlloc* pool, T elem)
+    {
+        if (NULL == head_ || head_->count == ELEMS)
+        {
+            Node* node = new(pool) Node();
+            if (NULL == node)
+                return ADSP_OUT_OF_RESOURCES;
+            LinkFront(node);
+        }
+        InsertFront(elem);
+        return ADSP_SUCCESS;
+    }
+
+private:
+    static_assert(ELEMS >= 2, "use UniList for single element nodes");
+
+    void LinkBack(Node* node)
+    {
+        if (NULL == head_)
+            head_ = node;
+        else
+            tail_->next = node;
+        tail_ = node;
+    }
+
+    void LinkFront(Node* node)
+    {
+        node->next = head_;
+        head_ = node;
+        if (NULL == tail_)
+            tail_ = node;
+    }
+
+    void InsertFront(T& elem)
+    {
+        for (size_t idx = head_->count; idx > 0; --idx)
+            head_->elems[idx] = head_->elems[idx - 1];
+        head_->elems[0] = elem;
+        ++head_->count;
+        ++size_;
+    }
+
+    /* Current size of the list. */
+    size_t size_;
+    Node* head_;
+    Node* tail_;
+};
+
+/*!
+  \brief Optional hash index of BiListPreAlloc, maps elem to slot index.
+  BUCKETS has to be power of two, elem has to be convertible to size_t
+  (pointers and integers are).
 */
+template<class T, size_t N, size_t BUCKETS>
+class BiListPreAllocIndex
+{
+public:
+    BiListPreAllocIndex()
+    {
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket)
+            buckets_[bucket] = N;
+    }
+
+    void Insert(const T& elem, size_t idx)
+    {
+        const size_t bucket = Bucket(elem);
+        next_[idx] = buckets_[bucket];
+        buckets_[bucket] = idx;
+    }
+
+    void Remove(const T& elem, size_t idx)
+    {
+        size_t* link = &buckets_[Bucket(elem)];
+        while (*link != idx)
+        {
+            assert(*link != N);
+            link = &next_[*link];
+        }
+        *link = next_[idx];
+    }
+
+    template<class Item>
+    size_t Find(const T& elem, const Item* items) const
+    {
+        for (size_t idx = buckets_[Bucket(elem)]; idx != N; idx = next_[idx])
+        {
+            if (items[idx].elem == elem)
+                return idx;
+        }
+        return INVALID_INDEX_BITMAP;
+    }
+
+private:
+    static_assert(BUCKETS != 0 && (BUCKETS & (BUCKETS - 1)) == 0, "bucket count has to be power of two");
+
+    static size_t Bucket(const T& elem)
+    {
+        // Fibonacci hashing, low bits of pointers are mostly alignment
+        return (size_t)(((uint32_t)(size_t)elem * 2654435769U) >> 16) & (BUCKETS - 1);
+    }
+
+    // slot index of the first entry in bucket, N terminates chains
+    size_t buckets_[BUCKETS];
+    size_t next_[N];
+};
+
 template<class T, size_t N>
+class BiListPreAllocIndex<T, N, 0>
+{
+public:
+    void Insert(const T& elem, size_t idx) {}
+    void Remove(const T& elem, size_t idx) {}
+    template<class Item>
+    size_t Find(const T& elem, const Item* items) const
+    {
+        return INVALID_INDEX_BITMAP;
+    }
+};
+
+/*!
+  \brief bi-directional list with pre allocated array
+
+  Unused items are chained into an embedded free list through their next pointer,
+  so taking and returning a slot is O(1). Items can be removed in O(1) by handle
+  with RemoveItem(). With HASH_BUCKETS != 0, Find() and Remove() by element go
+  through a hash index instead of walking the list.
+*/
+template<class T, size_t N, size_t HASH_BUCKETS = 0>
 class BiListPreAlloc
 {
 public:
@@ -311,7 +553,12 @@ public:
         {
         }
     };
-    BiListPreAlloc() :size_(0), head_(NULL), tail_(NULL){}
+    BiListPreAlloc() :size_(0), head_(NULL), tail_(NULL), free_(&items_[0])
+    {
+        for (size_t idx = 0; idx + 1 < N; ++idx)
+            items_[idx].next = &items_[idx + 1];
+        items_[N - 1].next = NULL;
+    }
     size_t GetSize() const { return size_; }
     size_t GetFreeSize() const { return N - size_; }
     Item* GetHead() { return head_; }
@@ -321,31 +568,22 @@ public:
 
     ErrorCode PushBack(T& elem)
     {
-        size_t idx = bitmap_.Alloc();
-        RETURN_EC_ON_FAIL(INVALID_INDEX_BITMAP != idx, ADSP_LIST_CANNOT_PUSH_BACK_ELEMENT);
-        ErrorCode ec = ADSP_LIST_CANNOT_PUSH_BACK_ELEMENT;
         ENTER_CRITICAL_SECTION(PUSH_BACK);
-        ++size_;
-        if (NULL == head_)
-        {
-            head_ = &items_[idx];
-            head_->prev = NULL;
-            head_->next = NULL;
-            head_->elem = elem;
-            tail_ = head_;
-            ec = ADSP_SUCCESS;
-        }
-        else if (NULL != tail_)
+        Item* new_it = AllocItem(elem);
+        if (new_it == NULL)
         {
-            tail_->next = &items_[idx];
-            items_[idx].elem = elem;
-            items_[idx].prev= tail_;
-            items_[idx].next = NULL;
-            tail_ = tail_->next;
-            ec = ADSP_SUCCESS;
+            LEAVE_CRITICAL_SECTION(PUSH_BACK);
+            return ADSP_LIST_CANNOT_PUSH_BACK_ELEMENT;
         }
+        new_it->prev = tail_;
+        new_it->next = NULL;
+        if (NULL == head_)
+            head_ = new_it;
+        else
+            tail_->next = new_it;
+        tail_ = new_it;
         LEAVE_CRITICAL_SECTION(PUSH_BACK);
-        return ec;
+        return ADSP_SUCCESS;
     }
 
     ErrorCode PutAfter(Item* it, T& elem)
@@ -357,29 +595,21 @@ public:
             assert(tail_ == NULL);
             return PushFront(elem);
         }
-        size_t idx = bitmap_.Alloc();
-        RETURN_EC_ON_FAIL(INVALID_INDEX_BITMAP != idx, ADSP_LIST_CANNOT_PUT_AFTER_ELEMENT);
         ENTER_CRITICAL_SECTION(PUT_AFTER);
-
-        ++size_;
-        Item* new_it = &items_[idx];
-        new_it->elem = elem;
+        Item* new_it = AllocItem(elem);
+        if (new_it == NULL)
+        {
+            LEAVE_CRITICAL_SECTION(PUT_AFTER);
+            return ADSP_LIST_CANNOT_PUT_AFTER_ELEMENT;
+        }
         Item* next_it = it->next;
+        new_it->next = next_it;
+        new_it->prev = it;
+        it->next = new_it;
         if (next_it == NULL)
-        {
-            new_it->next = NULL;
-            new_it->prev = it;
-            it->next = new_it;
             tail_ = new_it;
-        }
         else
-        {
-            new_it->next = next_it;
-            new_it->prev = it;
             next_it->prev = new_it;
-            it->next = new_it;
-        }
-
         LEAVE_CRITICAL_SECTION(PUT_AFTER);
         return ADSP_SUCCESS;
     }
@@ -393,118 +623,125 @@ public:
             assert(tail_ == NULL);
             return PushFront(elem);
         }
-        size_t idx = bitmap_.Alloc();
-        RETURN_EC_ON_FAIL(INVALID_INDEX_BITMAP != idx, ADSP_LIST_CANNOT_PUT_BEFORE_ELEMENT);
         ENTER_CRITICAL_SECTION(PUT_BEFORE);
-
-        ++size_;
-        Item* new_it = &items_[idx];
-        new_it->elem = elem;
+        Item* new_it = AllocItem(elem);
+        if (new_it == NULL)
+        {
+            LEAVE_CRITICAL_SECTION(PUT_BEFORE);
+            return ADSP_LIST_CANNOT_PUT_BEFORE_ELEMENT;
+        }
         Item* prev_it = it->prev;
+        new_it->next = it;
+        new_it->prev = prev_it;
+        it->prev = new_it;
         if (prev_it == NULL)
-        {
-            new_it->next = it;
-            new_it->prev = NULL;
-            it->prev = new_it;
             head_ = new_it;
-        }
         else
-        {
-            new_it->next = it;
-            new_it->prev = it->prev;
-            it->prev = new_it;
             prev_it->next = new_it;
-
-        }
         LEAVE_CRITICAL_SECTION(PUT_BEFORE);
         return ADSP_SUCCESS;
     }
 
     ErrorCode PushFront(T& elem)
     {
-        size_t idx = bitmap_.Alloc();
-        RETURN_EC_ON_FAIL(INVALID_INDEX_BITMAP != idx, ADSP_LIST_CANNOT_PUSH_FRONT_ELEMENT);
-
         ENTER_CRITICAL_SECTION(PUSH_FRONT);
-        ++size_;
-        if (NULL == head_)
+        Item* new_it = AllocItem(elem);
+        if (new_it == NULL)
         {
-            head_ = &items_[idx];
-            head_->prev = NULL;
-            head_->next = NULL;
-            head_->elem = elem;
-            tail_ = head_;
+            LEAVE_CRITICAL_SECTION(PUSH_FRONT);
+            return ADSP_LIST_CANNOT_PUSH_FRONT_ELEMENT;
         }
+        new_it->prev = NULL;
+        new_it->next = head_;
+        if (NULL == head_)
+            tail_ = new_it;
         else
-        {
-            items_[idx].elem = elem;
-            items_[idx].prev = NULL;
-            items_[idx].next = head_;
-            head_->prev = &items_[idx];
-            head_ = &items_[idx];
-        }
+            head_->prev = new_it;
+        head_ = new_it;
         LEAVE_CRITICAL_SECTION(PUSH_FRONT);
         return ADSP_SUCCESS;
     }
 
+    /*!
+      \brief Returns slot index of elem, INVALID_INDEX_BITMAP when not in list.
+      O(1) with hash index, otherwise walks the list (not all N slots).
+    */
     size_t Find(const T& elem) const
     {
-        for (size_t idx = 0; idx < N; ++idx)
+        if (HASH_BUCKETS != 0)
+            return index_.Find(elem, items_);
+        for (const Item* it = head_; it != NULL; it = it->next)
         {
-            if (bitmap_.isFree(idx))
-                continue;
-            if (items_[idx].elem == elem)
-            {
-                return idx;
-            }
+            if (it->elem == elem)
+                return it - items_;
         }
         return INVALID_INDEX_BITMAP;
     }
 
     ErrorCode Remove(T& elem)
     {
-        for (size_t idx = 0; idx < N; ++idx)
+        const size_t idx = Find(elem);
+        RETURN_EC_ON_FAIL(idx != INVALID_INDEX_BITMAP, ADSP_CANNOT_REMOVE_ELEMENT_FROM_LIST);
+        return RemoveItem(&items_[idx]);
+    }
+
+    /*!
+      \brief Unlinks item obtained from GetHead()/GetTail() or their links in O(1).
+      \return ADSP_CANNOT_REMOVE_ELEMENT_FROM_LIST when item is not in the list,
+              e.g. stale handle of already removed item
+    */
+    ErrorCode RemoveItem(Item* item)
+    {
+        RETURN_EC_ON_FAIL(item >= items_ && item < items_ + N, ADSP_CANNOT_REMOVE_ELEMENT_FROM_LIST);
+        ENTER_CRITICAL_SECTION(REMOVE_ELEMENT);
+        // only head of the list has no prev among linked items, free slots never have one
+        if (item->prev == NULL && item != head_)
         {
-            if (bitmap_.isFree(idx))
-                continue;
-            if (items_[idx].elem == elem)
-            {
-                ENTER_CRITICAL_SECTION(REMOVE_ELEMENT);
-                Item* prev = items_[idx].prev;
-                Item* next = items_[idx].next;
-                // remove head
-                if (&items_[idx] == head_)
-                {
-                    head_ = next;
-                    if (head_ != NULL)
-                    head_->prev = NULL;
-                }
-                // remove tail
-                if (&items_[idx] == tail_)
-                {
-                    tail_ = prev;
-                    if (tail_ != NULL)
-                    tail_->next = NULL;
-                }
-                if (prev != NULL && next != NULL)
-                {
-                    prev->next = next;
-                    next->prev = prev;
-                }
-                bitmap_.Free(idx);
-                --size_;
-                LEAVE_CRITICAL_SECTION(REMOVE_ELEMENT);
-                return ADSP_SUCCESS;
-            }
+            LEAVE_CRITICAL_SECTION(REMOVE_ELEMENT);
+            return ADSP_CANNOT_REMOVE_ELEMENT_FROM_LIST;
         }
-        return ADSP_CANNOT_REMOVE_ELEMENT_FROM_LIST;
+        Item* prev = item->prev;
+        Item* next = item->next;
+        if (prev != NULL)
+            prev->next = next;
+        else
+            head_ = next;
+        if (next != NULL)
+            next->prev = prev;
+        else
+            tail_ = prev;
+        index_.Remove(item->elem, item - items_);
+        item->prev = NULL;
+        item->next = free_;
+        free_ = item;
+        --size_;
+        LEAVE_CRITICAL_SECTION(REMOVE_ELEMENT);
+        return ADSP_SUCCESS;
     }
 private:
+    /*!
+      \brief Takes slot from free list and stores elem, NULL when list is full.
+      Called inside critical section.
+    */
+    Item* AllocItem(T& elem)
+    {
+        Item* item = free_;
+        if (item == NULL)
+            return NULL;
+        free_ = item->next;
+        item->elem = elem;
+        index_.Insert(elem, item - items_);
+        ++size_;
+        return item;
+    }
+
     Item items_[N];
     size_t size_;
     Item* head_;
     Item* tail_;
-    Bitmap<N> bitmap_;
+    // unused items linked through next
+    Item* free_;
+    BiListPreAllocIndex<T, N, HASH_BUCKETS> index_;
 };
 }
 
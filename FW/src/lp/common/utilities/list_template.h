@@ -15,12 +15,33 @@
 namespace dsp_fw
 {
 template <class T>
+class List;
+
+/*!
+  \brief Links embedded into listed objects (T derives from ListItem<T>).
+  Item records the list it belongs to, so membership check and removal
+  do not need to walk the list.
+*/
+template <class T>
 class ListItem
 {
 public:
-    ListItem(): next_item_(NULL), previous_item_(NULL)
+    ListItem(): next_item_(NULL), previous_item_(NULL), owner_list_(NULL)
     {        
     }
+    /*!
+      \brief Copy is not listed, links belong to the original item.
+    */
+    ListItem(const ListItem&): next_item_(NULL), previous_item_(NULL), owner_list_(NULL)
+    {
+    }
+    /*!
+      \brief Keeps own links and owner, item stays where it is listed.
+    */
+    ListItem& operator=(const ListItem&)
+    {
+        return *this;
+    }
     void SetNextItem(T* const next_item)
     {
         next_item_ = next_item;
@@ -37,23 +58,76 @@ public:
     {
         return previous_item_;
     }
+    /*!
+      \brief Returns list holding this item, NULL when not listed.
+    */
+    const List<T>* owner_list() const
+    {
+        return owner_list_;
+    }
 protected:
     T* next_item_;
     T* previous_item_;
+private:
+    friend class List<T>;
+    List<T>* owner_list_;
 };
 
+/*!
+  \brief Intrusive two way list, all operations except Splice() are O(1).
+
+  Iteration tolerates removal of the current item, next item is fetched
+  before the current one is handed out:
+  \code
+      for (List<Task>::Iterator it = tasks.begin(); it != tasks.end(); ++it)
+      {
+          if ((*it)->done())
+              tasks.RemoveElement(*it);
+      }
+      // C++11
+      for (Task* task : tasks) { ... }
+  \endcode
+*/
 template <class T>
 class List
 {
 public:
-    List(): tail_(NULL), head_(NULL) 
+    class Iterator
+    {
+    public:
+        explicit Iterator(T* item) : item_(item), next_(item != NULL ? item->next_item() : NULL)
+        {
+        }
+        T* operator*() const
+        {
+            return item_;
+        }
+        Iterator& operator++()
+        {
+            item_ = next_;
+            next_ = item_ != NULL ? item_->next_item() : NULL;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const
+        {
+            return item_ == other.item_;
+        }
+        bool operator!=(const Iterator& other) const
+        {
+            return item_ != other.item_;
+        }
+    private:
+        T* item_;
+        T* next_;
+    };
+
+    List(): items_counter_(0), tail_(NULL), head_(NULL) 
     {
     }    
     void AddElement(T * const Item)
     {
-        /* Check if existis in other list (zero element lists not verified) */
-        //assert(Item->previous_item() == NULL);
-        //assert(Item->next_item() == NULL);
+        /* Item must not be linked into any list */
+        assert(Item->owner_list_ == NULL);
         /* If list is empty set head and tail */
         if(items_counter_ == 0)
         {
@@ -63,10 +137,12 @@ public:
         }        
         else
         {
+            Item->SetNextItem(NULL);
             Item->SetPreviousItem(tail_);
             tail_->SetNextItem(Item);
         }
         tail_ = Item;
+        Item->owner_list_ = this;
         items_counter_++;
     }
     ErrorCode RemoveElement(T * const Item)
@@ -94,9 +170,49 @@ public:
         {
             tail_ = Item->previous_item();
         }
+        Item->SetNextItem(NULL);
+        Item->SetPreviousItem(NULL);
+        Item->owner_list_ = NULL;
         items_counter_--;
         return ADSP_SUCCESS;
     }
+    /*!
+      \brief Moves all items of other list to the end of this list, other becomes empty.
+      Links are moved in O(1), owner tags of moved items are updated one by one.
+    */
+    void Splice(List& other)
+    {
+        if (&other == this || other.head_ == NULL)
+            return;
+        for (T* item = other.head_; item != NULL; item = item->next_item())
+            item->owner_list_ = this;
+        if (head_ == NULL)
+        {
+            head_ = other.head_;
+        }
+        else
+        {
+            tail_->SetNextItem(other.head_);
+            other.head_->SetPreviousItem(tail_);
+        }
+        tail_ = other.tail_;
+        items_counter_ += other.items_counter_;
+        other.head_ = NULL;
+        other.tail_ = NULL;
+        other.items_counter_ = 0;
+    }
+    bool ExistInList(const T * const Item) const
+    {
+        return Item->owner_list() == this;
+    }
+    Iterator begin()
+    {
+        return Iterator(head_);
+    }
+    Iterator end()
+    {
+        return Iterator(NULL);
+    }
     T* head()
     {
         return head_;
@@ -113,20 +229,6 @@ private:
     uint16_t items_counter_;
     T* tail_;
     T* head_;
-    bool ExistInList(T * const Item)
-    {
-        T* current_item = head_;
-
-        while (NULL != current_item)
-        {
-            if (current_item == Item)
-            {
-                return true;
-            }
-            current_item = current_item->next_item();
-        }
-        return false;
-    }
 };
 }
 
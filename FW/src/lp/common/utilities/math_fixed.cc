@@ -0,0 +1,311 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Fixed-point math functions declared in math_fixed.h.
+  Range reduction is done on integer bits (leading zeros, quadrant/octant
+  folding), the remainder is evaluated by Chebyshev-fitted polynomials with
+  64-bit Horner steps, so no tables are needed and results are reproducible
+  across cores and the host build.
+*/
+
+#include "adsp_std_defs.h"
+#include "math_fixed.h"
+
+#define MATH_FIXED_LOG_FRAC     26
+#define MATH_FIXED_HALF_PI_Q31  0x40000000
+#define MATH_FIXED_TAN_PI_8_Q31 889516852   // tan(pi/8)
+
+// log2(1 + t) for t in [0, 1), Q2.30, max error 2.2e-10
+static const int32_t log2_coefs[] =
+{
+    0, 1549081938, -774537767, 516298484, -386642994, 306000086,
+    -243018193, 179798541, -112108087, 52287707, -15602240, 2184348
+};
+
+// 2^t for t in [0, 1), Q2.30, max error 1.2e-12
+static const int32_t exp2_coefs[] =
+{
+    1073741824, 744261118, 257941253, 59597033, 10327645, 1430944,
+    166622, 15197, 2013
+};
+
+// sin(pi / 2 * b) / b = pi / 2 + b^2 * P(b^2) for |b| <= 1, P in Q1.31, max error 2.7e-11
+#define MATH_FIXED_SIN_C0_Q31   3373259426LL    // pi / 2
+static const int32_t sin_coefs[] =
+{
+    -1387197332, 171138563, -10053783, 344144, -7370
+};
+
+// atan(r) / (pi * r) as polynomial of r^2 for |r| <= tan(pi/8), Q1.31, max error 2e-10
+static const int32_t atan_coefs[] =
+{
+    683565275, -227854911, 136700635, -97336501, 72251680, -41193731
+};
+
+/*!
+  \brief Evaluates polynomial at x given in Q1.31, result has format of coefs.
+*/
+static FORCE_INLINE int64_t horner_q31(const int32_t* coefs, uint32_t count, int64_t x)
+{
+    int64_t acc = coefs[count - 1];
+    for (int32_t i = count - 2; i >= 0; --i)
+    {
+        acc = ((acc * x + (1LL << 30)) >> 31) + coefs[i];
+    }
+    return acc;
+}
+
+static FORCE_INLINE int32_t log2_fx_core(uint32_t x, uint32_t frac_bits)
+{
+    if (x == 0)
+        return INT32_MIN;
+    const uint32_t lz = __builtin_clz(x);
+    // mantissa in [1, 2) with the leading one dropped, Q0.31
+    const uint32_t t = (x << lz) & 0x7FFFFFFF;
+    const int64_t frac = horner_q31(log2_coefs, sizeof(log2_coefs) / sizeof(log2_coefs[0]), t);
+    const int32_t exponent = 31 - (int32_t)lz - (int32_t)frac_bits;
+    const int64_t result = ((int64_t)exponent << MATH_FIXED_LOG_FRAC) +
+                           ((frac + (1 << (30 - MATH_FIXED_LOG_FRAC - 1))) >> (30 - MATH_FIXED_LOG_FRAC));
+    // log2 of values just below 2^32 rounds up to 32.0, which Q5.26 cannot hold
+    return result > INT32_MAX ? INT32_MAX : (int32_t)result;
+}
+
+static FORCE_INLINE uint32_t exp2_fx_core(int32_t x, uint32_t frac_bits)
+{
+    const int32_t integer = x >> MATH_FIXED_LOG_FRAC;
+    const uint32_t t = ((uint32_t)x << (31 - MATH_FIXED_LOG_FRAC)) & 0x7FFFFFFF;
+    // 2^t in [1, 2), Q2.30
+    const uint32_t mantissa = (uint32_t)horner_q31(exp2_coefs, sizeof(exp2_coefs) / sizeof(exp2_coefs[0]), t);
+    const int32_t shift = integer + (int32_t)frac_bits - 30;
+    if (shift >= 0)
+        return shift >= 2 ? UINT32_MAX : mantissa << shift;
+    if (shift <= -32)
+        return 0;
+    return (uint32_t)(((uint64_t)mantissa + (1ULL << (-shift - 1))) >> -shift);
+}
+
+static FORCE_INLINE uint32_t pow_fx_core(uint32_t base, int32_t exponent, uint32_t frac_bits)
+{
+    if (exponent == 0)
+        return frac_bits < 32 ? 1U << frac_bits : UINT32_MAX;
+    if (base == 0)
+        return exponent > 0 ? 0 : UINT32_MAX;
+    int64_t log = ((int64_t)log2_fx_core(base, frac_bits) * exponent) >> 16;
+    // anything beyond +-32 octaves saturates or underflows in exp2_fx_core
+    log = log > INT32_MAX ? INT32_MAX : log;
+    log = log < INT32_MIN ? INT32_MIN : log;
+    return exp2_fx_core((int32_t)log, frac_bits);
+}
+
+static FORCE_INLINE uint32_t isqrt64(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value)
+        bit >>= 2;
+    while (bit != 0)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+static FORCE_INLINE int32_t sqrt_q31_core(int32_t x)
+{
+    return x <= 0 ? 0 : (int32_t)isqrt64((uint64_t)x << 31);
+}
+
+static FORCE_INLINE int16_t sqrt_q15_core(int16_t x)
+{
+    return x <= 0 ? 0 : (int16_t)isqrt64((uint64_t)x << 15);
+}
+
+static FORCE_INLINE int32_t sin_q31_core(int32_t angle)
+{
+    // sin(pi * a) = sin(pi * (+-1 - a)), +1 and -1 are the same angle in Q1.31
+    if (angle > MATH_FIXED_HALF_PI_Q31 || angle < -MATH_FIXED_HALF_PI_Q31)
+        angle = (int32_t)(0x80000000U - (uint32_t)angle);
+    // angle in units of pi/2, |b| <= 1
+    const int64_t b = (int64_t)angle * 2;
+    const int64_t b2 = (b * b) >> 31;
+    const int64_t poly = horner_q31(sin_coefs, sizeof(sin_coefs) / sizeof(sin_coefs[0]), b2);
+    const int64_t slope = MATH_FIXED_SIN_C0_Q31 + ((poly * b2 + (1LL << 30)) >> 31);
+    int64_t result = (slope * b + (1LL << 30)) >> 31;
+    result = result > INT32_MAX ? INT32_MAX : result;
+    return result < INT32_MIN ? INT32_MIN : (int32_t)result;
+}
+
+static FORCE_INLINE int32_t cos_q31_core(int32_t angle)
+{
+    return sin_q31_core((int32_t)((uint32_t)angle + MATH_FIXED_HALF_PI_Q31));
+}
+
+static FORCE_INLINE int16_t round_q31_to_q15(int32_t value)
+{
+    const int32_t result = (int32_t)(((int64_t)value + 0x8000) >> 16);
+    return result > INT16_MAX ? INT16_MAX : (int16_t)result;
+}
+
+static FORCE_INLINE int32_t atan2_q31_core(int32_t y, int32_t x)
+{
+    const int64_t abs_x = x < 0 ? -(int64_t)x : x;
+    const int64_t abs_y = y < 0 ? -(int64_t)y : y;
+    const bool swap = abs_y > abs_x;
+    const int64_t num = swap ? abs_x : abs_y;
+    const int64_t den = swap ? abs_y : abs_x;
+    if (den == 0)
+        return 0;
+
+    // octant angle in [0, pi/4], above pi/8 continue from pi/4 to stay in the polynomial range
+    int64_t ratio;
+    int32_t angle;
+    if ((num << 31) > den * MATH_FIXED_TAN_PI_8_Q31)
+    {
+        ratio = (num - den) * (1LL << 31) / (num + den);
+        angle = MATH_FIXED_HALF_PI_Q31 / 2;
+    }
+    else
+    {
+        ratio = (num << 31) / den;
+        angle = 0;
+    }
+    const int64_t poly = horner_q31(atan_coefs, sizeof(atan_coefs) / sizeof(atan_coefs[0]), (ratio * ratio) >> 31);
+    angle += (int32_t)((poly * ratio + (1LL << 30)) >> 31);
+
+    uint32_t result = angle;
+    if (swap)
+        result = MATH_FIXED_HALF_PI_Q31 - result;
+    if (x < 0)
+        result = 0x80000000U - result;
+    if (y < 0)
+        result = 0U - result;
+    return (int32_t)result;
+}
+
+int32_t log2_fx(uint32_t x, uint32_t frac_bits)
+{
+    return log2_fx_core(x, frac_bits);
+}
+
+uint32_t exp2_fx(int32_t x, uint32_t frac_bits)
+{
+    return exp2_fx_core(x, frac_bits);
+}
+
+uint32_t pow_fx(uint32_t base, int32_t exponent, uint32_t frac_bits)
+{
+    return pow_fx_core(base, exponent, frac_bits);
+}
+
+int32_t sqrt_q31(int32_t x)
+{
+    return sqrt_q31_core(x);
+}
+
+int16_t sqrt_q15(int16_t x)
+{
+    return sqrt_q15_core(x);
+}
+
+int32_t sin_q31(int32_t angle)
+{
+    return sin_q31_core(angle);
+}
+
+int32_t cos_q31(int32_t angle)
+{
+    return cos_q31_core(angle);
+}
+
+int16_t sin_q15(int16_t angle)
+{
+    return round_q31_to_q15(sin_q31_core((int32_t)angle * 0x10000));
+}
+
+int16_t cos_q15(int16_t angle)
+{
+    return round_q31_to_q15(cos_q31_core((int32_t)angle * 0x10000));
+}
+
+int32_t atan2_q31(int32_t y, int32_t x)
+{
+    return atan2_q31_core(y, x);
+}
+
+int32_t atan_q31(int32_t x)
+{
+    return atan2_q31_core(x, INT32_MAX);
+}
+
+void log2_fx_v(int32_t* out, const uint32_t* in, size_t n, uint32_t frac_bits)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = log2_fx_core(in[i], frac_bits);
+}
+
+void exp2_fx_v(uint32_t* out, const int32_t* in, size_t n, uint32_t frac_bits)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = exp2_fx_core(in[i], frac_bits);
+}
+
+void pow_fx_v(uint32_t* out, const uint32_t* base, const int32_t* exponent, size_t n,
+              uint32_t frac_bits)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = pow_fx_core(base[i], exponent[i], frac_bits);
+}
+
+void sqrt_q31_v(int32_t* out, const int32_t* in, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = sqrt_q31_core(in[i]);
+}
+
+void sqrt_q15_v(int16_t* out, const int16_t* in, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = sqrt_q15_core(in[i]);
+}
+
+void sin_q31_v(int32_t* out, const int32_t* in, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = sin_q31_core(in[i]);
+}
+
+void cos_q31_v(int32_t* out, const int32_t* in, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = cos_q31_core(in[i]);
+}
+
+void sin_q15_v(int16_t* out, const int16_t* in, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = round_q31_to_q15(sin_q31_core((int32_t)in[i] * 0x10000));
+}
+
+void cos_q15_v(int16_t* out, const int16_t* in, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = round_q31_to_q15(cos_q31_core((int32_t)in[i] * 0x10000));
+}
+
+void atan2_q31_v(int32_t* out, const int32_t* y, const int32_t* x, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        out[i] = atan2_q31_core(y[i], x[i]);
+}
@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef __MATH_FIXED__
+#define __MATH_FIXED__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Fixed-point counterparts of math_fw.h for integer-only audio paths.
+ * Notation: Qm.n is signed with n fractional bits, UQm.n is unsigned.
+ * Angles are Q1.31 (or Q1.15) fractions of pi, so the full circle maps onto the
+ * integer range and wraps naturally; 0x40000000 is pi/2.
+ *
+ * log2/exp2/pow take the position of the binary point of the linear value in
+ * frac_bits (0..31), e.g. 31 for Q1.31 levels or 16 for UQ16.16 gains.
+ * Logarithms are Q5.26, exponents of pow_fx are Q15.16.
+ *
+ * Max error against the exact result:
+ *   log2_fx     2^-26 (1 LSB), saturated to INT32_MAX within 2^-26 of 32.0 (x close to 2^32, frac_bits 0)
+ *   exp2_fx     1 LSB + 2^-29 relative
+ *   pow_fx      exp2_fx error + |exponent| * 2^-26 relative
+ *   sqrt_q31    1 LSB (result is truncated)
+ *   sin_q31     3 LSB, sin_q15 1 LSB
+ *   cos_q31     3 LSB, cos_q15 1 LSB
+ *   atan2_q31   2 LSB
+ * ut/math_fixed_test checks these bounds and prints the cost next to math_fw.h batch
+ * variants. sqrt is bit serial (16-32 conditional steps), far slower than sqrtf_fw_v
+ * where a float unit is available.
+ */
+
+/*! \brief Returns log2(x / 2^frac_bits) in Q5.26, INT32_MIN for x == 0. */
+int32_t log2_fx(uint32_t x, uint32_t frac_bits);
+/*! \brief Returns 2^x for x in Q5.26, scaled by 2^frac_bits and saturated to UINT32_MAX. */
+uint32_t exp2_fx(int32_t x, uint32_t frac_bits);
+/*! \brief Returns base^exponent, base and result share frac_bits, exponent is Q15.16. */
+uint32_t pow_fx(uint32_t base, int32_t exponent, uint32_t frac_bits);
+/*! \brief Square root of Q1.31 value, negative input gives 0. */
+int32_t sqrt_q31(int32_t x);
+int16_t sqrt_q15(int16_t x);
+/*! \brief Sine of angle given as Q1.31 fraction of pi, result in Q1.31. */
+int32_t sin_q31(int32_t angle);
+int32_t cos_q31(int32_t angle);
+int16_t sin_q15(int16_t angle);
+int16_t cos_q15(int16_t angle);
+/*! \brief Angle of (x, y) as Q1.31 fraction of pi, in [-1, 1). atan2_q31(0, 0) is 0. */
+int32_t atan2_q31(int32_t y, int32_t x);
+/*! \brief Arc tangent of Q1.31 value, result in Q1.31 fraction of pi within [-1/4, 1/4]. */
+int32_t atan_q31(int32_t x);
+
+/*
+ * Batch variants, out[i] = f(in[i]) for i < n. out may alias in when element
+ * types match. Results are bit-exact with the scalar functions.
+ */
+void log2_fx_v(int32_t* out, const uint32_t* in, size_t n, uint32_t frac_bits);
+void exp2_fx_v(uint32_t* out, const int32_t* in, size_t n, uint32_t frac_bits);
+void pow_fx_v(uint32_t* out, const uint32_t* base, const int32_t* exponent, size_t n,
+              uint32_t frac_bits);
+void sqrt_q31_v(int32_t* out, const int32_t* in, size_t n);
+void sqrt_q15_v(int16_t* out, const int16_t* in, size_t n);
+void sin_q31_v(int32_t* out, const int32_t* in, size_t n);
+void cos_q31_v(int32_t* out, const int32_t* in, size_t n);
+void sin_q15_v(int16_t* out, const int16_t* in, size_t n);
+void cos_q15_v(int16_t* out, const int16_t* in, size_t n);
+void atan2_q31_v(int32_t* out, const int32_t* y, const int32_t* x, size_t n);
+
+#endif /* __MATH_FIXED__ */
@@ -5,6 +5,8 @@
 #ifndef __MATH_FW__
 #define __MATH_FW__
 
+#include <stddef.h>
+
 // Obtaining low and high part of uint16_t
 #define UINT16_GET_LOW_PART(x)  (x & 0xFF)
 #define UINT16_GET_HIGH_PART(x) ((x >> 8) & 0xFF)
@@ -22,4 +24,70 @@ float sinf_fw(float arg);
 float cosf_fw(float arg);
 float atanf_fw(float arg);
 
+/*
+ * Batch variants, out[i] = f(in[i]) for i < n. out may alias in.
+ * Branch-free polynomial approximations with no calls in the loops, so compilers can
+ * vectorize them: g++ -O3 does for SSE/AVX, measured 1.1-4x faster than scalar libm
+ * with SSE2 and 3-20x with AVX2 (ut/math_fw_test). Use for HiFi float units depends
+ * on the Xtensa compiler, ut/math_fw_test prints the cycles there.
+ * Denormal inputs and results are treated as zero. Max error against correctly rounded result:
+ *   expf_fw_v    1 ULP
+ *   logf_fw_v    1 ULP
+ *   log10f_fw_v  2 ULP
+ *   powf_fw_v    (4 + |exponent * ln(base)|) ULP, measured 22 ULP for 10^x, |x| <= 10
+ *   sqrtf_fw_v   1 ULP
+ *   sinf_fw_v    1.5 ULP for |x| <= pi, 8e-8 absolute for |x| <= 8192
+ *   cosf_fw_v    1.5 ULP for |x| <= pi, 8e-8 absolute for |x| <= 8192
+ *   atanf_fw_v   3 ULP
+ * Special values follow C pow()/exp(): NaN propagates, exp overflows to inf and
+ * underflows to 0, pow(x, 0) and pow(1, y) are 1, negative base is defined for
+ * integral exponents only (NaN otherwise). sin/cos of inf and NaN is NaN, arguments
+ * beyond +-2^22 (where float spacing is 0.5 rad) are saturated to it.
+ */
+void expf_fw_v(float* out, const float* in, size_t n);
+void logf_fw_v(float* out, const float* in, size_t n);
+void log10f_fw_v(float* out, const float* in, size_t n);
+void powf_fw_v(float* out, const float* base, const float* exponent, size_t n);
+void sqrtf_fw_v(float* out, const float* in, size_t n);
+void sinf_fw_v(float* out, const float* in, size_t n);
+void cosf_fw_v(float* out, const float* in, size_t n);
+void atanf_fw_v(float* out, const float* in, size_t n);
+
+/*
+ * Accuracy tiers for callers which do not need full float precision (meters,
+ * UI levels, control rate smoothing). Each tier has its own range reduction and
+ * lower degree polynomial, full tier is the plain function above.
+ * ut/math_fw_test prints the cost of every tier next to the full one. On x86 host
+ * glibc (table based) is faster than both tiers, the gain is for HiFi cores.
+ * Max error, relative for exp, absolute for the others:
+ *                 _fast           _medium
+ *   expf_fw_*     1e-4 (13 b)     3.6e-6 (18 b)
+ *   logf_fw_*     2e-5 (15.6 b)   9.3e-7 (20 b)
+ *   log10f_fw_*   logf_fw_* error * log10(e)
+ *   powf_fw_*     exp error + |exponent| * log error, relative
+ *   sinf_fw_*     3.1e-4 (11.7 b) 1.2e-6 (19.7 b) for |x| <= 1000
+ *   cosf_fw_*     3.1e-4 (11.7 b) 1.2e-6 (19.7 b) for |x| <= 1000
+ *   atanf_fw_*    1.4e-4 (12.8 b) 5.3e-7 (20.8 b)
+ * Special values: exp saturates to [FLT_MIN, FLT_MAX], log of zero/denormal gives -inf, negative gives NaN,
+ * NaN propagates through all of them. pow resolves negative bases, zero and unit
+ * cases like powf_fw_v. sin/cos of inf and NaN is NaN, arguments beyond +-2^22 are
+ * saturated to it (the accuracy bounds hold for |x| <= 1000 only).
+ * log bounds hold for arguments in [0.01, 100], beyond that rounding of the result
+ * adds up to half ULP of it (3.8e-6 at the ends of float range).
+ */
+float expf_fw_fast(float arg);
+float expf_fw_medium(float arg);
+float logf_fw_fast(float arg);
+float logf_fw_medium(float arg);
+float log10f_fw_fast(float arg);
+float log10f_fw_medium(float arg);
+float powf_fw_fast(float base, float exponent);
+float powf_fw_medium(float base, float exponent);
+float sinf_fw_fast(float arg);
+float sinf_fw_medium(float arg);
+float cosf_fw_fast(float arg);
+float cosf_fw_medium(float arg);
+float atanf_fw_fast(float arg);
+float atanf_fw_medium(float arg);
+
 #endif /* __FW_MATH__ */
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Bit manipulation helpers and constants shared by math_fw implementations.
+  Not to be included outside of math_fw sources.
+*/
+
+#ifndef __MATH_FW_INTERNAL__
+#define __MATH_FW_INTERNAL__
+
+#include "adsp_std_defs.h"
+
+#define MATH_FW_LOG2E       1.44269504088896341f
+#define MATH_FW_LN2_HI      0.693359375f
+#define MATH_FW_LN2_LO      -2.12194440e-4f
+#define MATH_FW_LOG10E      0.434294481903251828f
+#define MATH_FW_2_OVER_PI   0.636619772367581343f
+#define MATH_FW_PI_2        1.57079632679489662f
+#define MATH_FW_PI_4        0.785398163397448310f
+#define MATH_FW_PI_2_HI     1.5703125f
+#define MATH_FW_PI_2_MID    4.83751296997070312e-4f
+#define MATH_FW_PI_2_LO     7.54978995489188216e-8f
+// pi/2 - MATH_FW_PI_2_HI
+#define MATH_FW_PI_2_TAIL   4.83826794896619231e-4f
+#define MATH_FW_EXP_MAX     88.72283905f
+#define MATH_FW_EXP_MIN     -87.33654475f
+#define MATH_FW_FLT_MIN     1.17549435e-38f
+// sin/cos arguments are saturated here, float spacing is already 0.5 rad at 2^22
+#define MATH_FW_TRIG_MAX    4194304.0f
+
+static FORCE_INLINE uint32_t float_as_bits(float value)
+{
+    union { float f; uint32_t u; } cast;
+    cast.f = value;
+    return cast.u;
+}
+
+static FORCE_INLINE float bits_as_float(uint32_t value)
+{
+    union { float f; uint32_t u; } cast;
+    cast.u = value;
+    return cast.f;
+}
+
+/*!
+  \brief Returns cond ? if_true : if_false through bit masks.
+  Float ?: with computed operands stays a branch unless FP traps are disabled
+  (-fno-trapping-math), which keeps the batch loops from vectorizing. For the same
+  reason conditions are combined with | and & instead of || and &&.
+*/
+static FORCE_INLINE float select_fw(bool cond, float if_true, float if_false)
+{
+    const uint32_t mask = 0u - (uint32_t)cond;
+    return bits_as_float((float_as_bits(if_true) & mask) | (float_as_bits(if_false) & ~mask));
+}
+
+/*!
+  \brief Clamps value to [lo, hi], NaN gives hi, so the result always converts to int.
+*/
+static FORCE_INLINE float clamp_fw(float value, float lo, float hi)
+{
+    value = select_fw(value < hi, value, hi);
+    return select_fw(value > lo, value, lo);
+}
+
+static FORCE_INLINE float abs_bits_fw(float value)
+{
+    return bits_as_float(float_as_bits(value) & 0x7FFFFFFF);
+}
+
+/*!
+  \brief True for inf and NaN.
+*/
+static FORCE_INLINE bool is_not_finite_fw(float value)
+{
+    return (float_as_bits(value) & 0x7F800000) == 0x7F800000;
+}
+
+/*!
+  \brief Rounds to nearest integer, valid for |value| < 2^22.
+*/
+static FORCE_INLINE float round_fw(float value)
+{
+    const float magic = 12582912.0f;  // 1.5 * 2^23
+    return (value + magic) - magic;
+}
+
+/*!
+  \brief Returns value * 2^n for n in [-127, 128].
+  2^n is split in two factors, so n = 128 after rounding does not overflow exponent field.
+*/
+static FORCE_INLINE float scale_pow2_fw(float value, int32_t n)
+{
+    const int32_t n_half = n >> 1;
+    const float scale_lo = bits_as_float((uint32_t)(n_half + 127) << 23);
+    const float scale_hi = bits_as_float((uint32_t)(n - n_half + 127) << 23);
+    return value * scale_lo * scale_hi;
+}
+
+/*!
+  \brief Splits arg into exponent and mantissa in [sqrt(0.5), sqrt(2)), returns mantissa - 1.
+*/
+static FORCE_INLINE float split_log_fw(float arg, float* exponent)
+{
+    const uint32_t bits = float_as_bits(arg);
+    const int32_t adj = (int32_t)(bits - 0x3F3504F3) >> 23;
+    *exponent = (float)adj;
+    return bits_as_float(bits - ((uint32_t)adj << 23)) - 1.0f;
+}
+
+/*!
+  \brief Resolves special cases of logarithm by selects, result is returned for finite positive arg.
+*/
+static FORCE_INLINE float log_special_fw(float arg, float result)
+{
+    const float inf = bits_as_float(0x7F800000);
+    result = select_fw(arg == inf, inf, result);
+    // denormals are treated as zero
+    result = select_fw(arg < MATH_FW_FLT_MIN, -inf, result);
+    result = select_fw((arg < 0.0f) | (arg != arg), bits_as_float(0x7FC00000), result);
+    return result;
+}
+
+/*!
+  \brief Resolves special cases of C pow() by selects, result is exp(exponent * log|base|).
+  Negative base is defined for integral exponents only, odd ones keep the sign.
+*/
+static FORCE_INLINE float pow_special_fw(float base, float exponent, float result)
+{
+    // floats of magnitude 2^24 and above are even integers
+    const bool huge = abs_bits_fw(exponent) >= 16777216.0f;
+    // NaN exponent converts as 0 and is not integral below
+    const int32_t exponent_int = (int32_t)select_fw(huge | (exponent != exponent), 0.0f, exponent);
+    const bool integral = huge | ((float)exponent_int == exponent);
+    const uint32_t odd_sign = ((uint32_t)exponent_int << 31) & float_as_bits(base);
+    result = bits_as_float(float_as_bits(result) ^ odd_sign);
+    result = select_fw((base < 0.0f) & !integral, bits_as_float(0x7FC00000), result);
+    // 0 * log(0) and inf * log(1) would give NaN
+    result = select_fw((exponent == 0.0f) | (base == 1.0f), 1.0f, result);
+    return result;
+}
+
+#endif /* __MATH_FW_INTERNAL__ */
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Reduced accuracy tiers of math_fw.h functions.
+  Same reduction scheme as the full precision batch variants, with Chebyshev
+  fitted polynomials of lower degree and shorter reduction constants.
+*/
+
+#include "adsp_std_defs.h"
+#include "math_fw.h"
+#include "math_fw_internal.h"
+
+/*!
+  \brief Returns n of arg = n * ln2 + r, arg saturated to the float range of the result.
+  NaN is reduced as MATH_FW_EXP_MAX, so the conversion of n stays defined.
+*/
+static FORCE_INLINE float expf_fw_reduce(float arg, float* r)
+{
+    arg = clamp_fw(arg, MATH_FW_EXP_MIN, MATH_FW_EXP_MAX);
+    const float n = round_fw(arg * MATH_FW_LOG2E);
+    *r = (arg - n * MATH_FW_LN2_HI) - n * MATH_FW_LN2_LO;
+    return n;
+}
+
+float expf_fw_fast(float arg)
+{
+    float r;
+    const float n = expf_fw_reduce(arg, &r);
+    float p = 1.676701188e-01f;
+    p = p * r + 5.050222842e-01f;
+    p = p * r + 9.999849286e-01f;
+    p = p * r + 9.999245570e-01f;
+    return select_fw(arg != arg, arg, scale_pow2_fw(p, (int32_t)n));
+}
+
+float expf_fw_medium(float arg)
+{
+    float r;
+    const float n = expf_fw_reduce(arg, &r);
+    float p = 4.187564445e-02f;
+    p = p * r + 1.679214302e-01f;
+    p = p * r + 4.999937214e-01f;
+    p = p * r + 9.999622947e-01f;
+    p = p * r + 1.0f;
+    return select_fw(arg != arg, arg, scale_pow2_fw(p, (int32_t)n));
+}
+
+float logf_fw_fast(float arg)
+{
+    float e;
+    const float x = split_log_fw(arg, &e);
+    float p = 1.734863154e-01f;
+    p = p * x - 2.701022827e-01f;
+    p = p * x + 3.366878160e-01f;
+    p = p * x - 4.995021092e-01f;
+    p = p * x + 9.999621704e-01f;
+    return log_special_fw(arg, (p * x + e * MATH_FW_LN2_LO) + e * MATH_FW_LN2_HI);
+}
+
+float logf_fw_medium(float arg)
+{
+    float e;
+    const float x = split_log_fw(arg, &e);
+    float p = 1.165780614e-01f;
+    p = p * x - 1.857384013e-01f;
+    p = p * x + 2.052544362e-01f;
+    p = p * x - 2.492033626e-01f;
+    p = p * x + 3.331356329e-01f;
+    p = p * x - 5.000087739e-01f;
+    p = p * x + 1.000001027e+00f;
+    return log_special_fw(arg, (p * x + e * MATH_FW_LN2_LO) + e * MATH_FW_LN2_HI);
+}
+
+float log10f_fw_fast(float arg)
+{
+    return logf_fw_fast(arg) * MATH_FW_LOG10E;
+}
+
+float log10f_fw_medium(float arg)
+{
+    return logf_fw_medium(arg) * MATH_FW_LOG10E;
+}
+
+float powf_fw_fast(float base, float exponent)
+{
+    return pow_special_fw(base, exponent, expf_fw_fast(exponent * logf_fw_fast(abs_bits_fw(base))));
+}
+
+float powf_fw_medium(float base, float exponent)
+{
+    return pow_special_fw(base, exponent, expf_fw_medium(exponent * logf_fw_medium(abs_bits_fw(base))));
+}
+
+/*!
+  \brief Evaluates sine (cosine if cos_shift is 1) of arg.
+  Arguments beyond MATH_FW_TRIG_MAX are saturated before the quadrant is converted
+  to int, inf and NaN give NaN.
+*/
+static FORCE_INLINE float sinf_fw_fast_poly(float arg, int32_t cos_shift)
+{
+    const float x = clamp_fw(arg, -MATH_FW_TRIG_MAX, MATH_FW_TRIG_MAX);
+    const float j = round_fw(x * MATH_FW_2_OVER_PI);
+    const float r = (x - j * MATH_FW_PI_2_HI) - j * MATH_FW_PI_2_TAIL;
+    const int32_t quadrant = (int32_t)j + cos_shift;
+    const float z = r * r;
+    const float ps = (-1.615918247e-01f * z + 9.996094192e-01f) * r;
+    const float pc = (4.039737638e-02f * z - 4.997074250e-01f) * z + 9.999899798e-01f;
+    const float result = (quadrant & 1) ? pc : ps;
+    return is_not_finite_fw(arg) ? bits_as_float(0x7FC00000) : ((quadrant & 2) ? -result : result);
+}
+
+static FORCE_INLINE float sinf_fw_medium_poly(float arg, int32_t cos_shift)
+{
+    const float x = clamp_fw(arg, -MATH_FW_TRIG_MAX, MATH_FW_TRIG_MAX);
+    const float j = round_fw(x * MATH_FW_2_OVER_PI);
+    const float r = ((x - j * MATH_FW_PI_2_HI) - j * MATH_FW_PI_2_MID) - j * MATH_FW_PI_2_LO;
+    const int32_t quadrant = (int32_t)j + cos_shift;
+    const float z = r * r;
+    const float ps = ((8.151506332e-03f * z - 1.666247219e-01f) * z + 9.999985633e-01f) * r;
+    const float pc = ((-1.358577927e-03f * z + 4.165501492e-02f) * z - 4.999985642e-01f) * z +
+                     9.999999723e-01f;
+    const float result = (quadrant & 1) ? pc : ps;
+    return is_not_finite_fw(arg) ? bits_as_float(0x7FC00000) : ((quadrant & 2) ? -result : result);
+}
+
+float sinf_fw_fast(float arg)
+{
+    return sinf_fw_fast_poly(arg, 0);
+}
+
+float sinf_fw_medium(float arg)
+{
+    return sinf_fw_medium_poly(arg, 0);
+}
+
+float cosf_fw_fast(float arg)
+{
+    return sinf_fw_fast_poly(arg, 1);
+}
+
+float cosf_fw_medium(float arg)
+{
+    return sinf_fw_medium_poly(arg, 1);
+}
+
+/*!
+  \brief Reduces |arg| > 1 through atan(x) = pi/2 - atan(1/x), returns reduced argument.
+*/
+static FORCE_INLINE float atanf_fw_reduce(float arg, float* base, float* sign)
+{
+    const float x_abs = fabsf_fw(arg);
+    const bool big = x_abs > 1.0f;
+    *base = big ? MATH_FW_PI_2 : 0.0f;
+    *sign = big ? -1.0f : 1.0f;
+    return big ? 1.0f / x_abs : x_abs;
+}
+
+float atanf_fw_fast(float arg)
+{
+    float base, sign;
+    const float x = atanf_fw_reduce(arg, &base, &sign);
+    const float z = x * x;
+    float p = -4.335934372e-02f;
+    p = p * z + 1.540951672e-01f;
+    p = p * z - 3.252304651e-01f;
+    p = p * z + 9.997528403e-01f;
+    const float y = base + sign * p * x;
+    return (arg < 0.0f) ? -y : y;
+}
+
+float atanf_fw_medium(float arg)
+{
+    float base, sign;
+    const float x = atanf_fw_reduce(arg, &base, &sign);
+    const float z = x * x;
+    float p = 7.648353927e-03f;
+    p = p * z - 3.636043086e-02f;
+    p = p * z + 8.312645301e-02f;
+    p = p * z - 1.344786406e-01f;
+    p = p * z + 1.987204027e-01f;
+    p = p * z - 3.332567804e-01f;
+    p = p * z + 9.999992256e-01f;
+    const float y = base + sign * p * x;
+    return (arg < 0.0f) ? -y : y;
+}
@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Batch variants of math_fw.h functions.
+  Every element is evaluated by the same branch-free sequence (range reduction,
+  polynomial, reconstruction through exponent bits) with selects done on bit masks
+  (select_fw), so the loops have neither branches nor calls and can be vectorized.
+  g++ -O3 vectorizes all of them for SSE/AVX (check with -fopt-info-vec).
+  Polynomials are Cephes single precision minimax approximations.
+*/
+
+#include "adsp_std_defs.h"
+#include "math_fw.h"
+#include "math_fw_internal.h"
+
+static FORCE_INLINE float expf_fw_poly(float arg)
+{
+    const float x = clamp_fw(arg, MATH_FW_EXP_MIN, MATH_FW_EXP_MAX);
+    const float n = round_fw(x * MATH_FW_LOG2E);
+    const float r = (x - n * MATH_FW_LN2_HI) - n * MATH_FW_LN2_LO;
+    float p = 1.9875691500E-4f;
+    p = p * r + 1.3981999507E-3f;
+    p = p * r + 8.3334519073E-3f;
+    p = p * r + 4.1665795894E-2f;
+    p = p * r + 1.6666665459E-1f;
+    p = p * r + 5.0000001201E-1f;
+    p = p * r * r + r + 1.0f;
+    float result = scale_pow2_fw(p, (int32_t)n);
+
+    const float inf = bits_as_float(0x7F800000);
+    result = select_fw(arg > MATH_FW_EXP_MAX, inf, result);
+    // results below FLT_MIN would be denormal, flushed to zero like denormal inputs
+    result = select_fw(arg < MATH_FW_EXP_MIN, 0.0f, result);
+    result = select_fw(arg != arg, arg, result);
+    return result;
+}
+
+static FORCE_INLINE float logf_fw_poly(float arg)
+{
+    float e;
+    const float x = split_log_fw(arg, &e);
+    const float z = x * x;
+    float y = 7.0376836292E-2f;
+    y = y * x - 1.1514610310E-1f;
+    y = y * x + 1.1676998740E-1f;
+    y = y * x - 1.2420140846E-1f;
+    y = y * x + 1.4249322787E-1f;
+    y = y * x - 1.6668057665E-1f;
+    y = y * x + 2.0000714765E-1f;
+    y = y * x - 2.4999993993E-1f;
+    y = y * x + 3.3333331174E-1f;
+    y = y * x * z;
+    y += e * MATH_FW_LN2_LO;
+    y -= 0.5f * z;
+    return log_special_fw(arg, x + y + e * MATH_FW_LN2_HI);
+}
+
+static FORCE_INLINE float sqrtf_fw_poly(float arg)
+{
+    // reciprocal square root estimate refined by two Newton-Raphson steps
+    float y = bits_as_float(0x5F3759DF - (float_as_bits(arg) >> 1));
+    y = y * (1.5f - 0.5f * arg * y * y);
+    y = y * (1.5f - 0.5f * arg * y * y);
+    float s = arg * y;
+    s += 0.5f * y * (arg - s * s);
+
+    const float inf = bits_as_float(0x7F800000);
+    s = select_fw(arg == inf, inf, s);
+    // denormals are treated as zero
+    s = select_fw(arg < MATH_FW_FLT_MIN, 0.0f, s);
+    s = select_fw(arg < 0.0f, bits_as_float(0x7FC00000), s);
+    return s;
+}
+
+/*!
+  \brief Evaluates sine (cosine if cos_shift is 1) of arg.
+  Argument is reduced to [-pi/4, pi/4] with 3-part pi/2, quadrant selects the polynomial.
+  Arguments beyond MATH_FW_TRIG_MAX are saturated, inf and NaN give NaN.
+*/
+static FORCE_INLINE float sinf_fw_poly(float arg, int32_t cos_shift)
+{
+    const float x = clamp_fw(arg, -MATH_FW_TRIG_MAX, MATH_FW_TRIG_MAX);
+    const float j = round_fw(x * MATH_FW_2_OVER_PI);
+    const float r = ((x - j * MATH_FW_PI_2_HI) - j * MATH_FW_PI_2_MID) - j * MATH_FW_PI_2_LO;
+    const int32_t quadrant = (int32_t)j + cos_shift;
+    const float z = r * r;
+
+    float ps = -1.9515295891E-4f;
+    ps = ps * z + 8.3321608736E-3f;
+    ps = ps * z - 1.6666654611E-1f;
+    ps = ps * z * r + r;
+
+    float pc = 2.443315711809948E-5f;
+    pc = pc * z - 1.388731625493765E-3f;
+    pc = pc * z + 4.166664568298827E-2f;
+    pc = pc * z * z - 0.5f * z + 1.0f;
+
+    float result = select_fw((quadrant & 1) != 0, pc, ps);
+    result = select_fw((quadrant & 2) != 0, -result, result);
+    return select_fw(is_not_finite_fw(arg), bits_as_float(0x7FC00000), result);
+}
+
+static FORCE_INLINE float atanf_fw_poly(float arg)
+{
+    const float x_abs = abs_bits_fw(arg);
+    const bool big = x_abs > 2.414213562373095f;
+    const bool mid = x_abs > 0.4142135623730950f;
+    // argument reduction through tan(a - b) identities, selected without branches
+    const float num = select_fw(big, -1.0f, select_fw(mid, x_abs - 1.0f, x_abs));
+    const float den = select_fw(big, x_abs, select_fw(mid, x_abs + 1.0f, 1.0f));
+    const float x = num / den;
+    const float base = select_fw(big, MATH_FW_PI_2, select_fw(mid, MATH_FW_PI_4, 0.0f));
+    const float z = x * x;
+    float y = 8.05374449538e-2f;
+    y = y * z - 1.38776856032E-1f;
+    y = y * z + 1.99777106478E-1f;
+    y = y * z - 3.33329491539E-1f;
+    y = base + (y * z * x + x);
+    return select_fw(arg < 0.0f, -y, y);
+}
+
+void expf_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = expf_fw_poly(in[idx]);
+    }
+}
+
+void logf_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = logf_fw_poly(in[idx]);
+    }
+}
+
+void log10f_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = logf_fw_poly(in[idx]) * MATH_FW_LOG10E;
+    }
+}
+
+/*!
+  \brief Evaluates base^exponent as exp(exponent * log|base|) with special cases of C pow() resolved by selects.
+*/
+static FORCE_INLINE float powf_fw_poly(float base, float exponent)
+{
+    return pow_special_fw(base, exponent, expf_fw_poly(exponent * logf_fw_poly(abs_bits_fw(base))));
+}
+
+void powf_fw_v(float* out, const float* base, const float* exponent, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = powf_fw_poly(base[idx], exponent[idx]);
+    }
+}
+
+void sqrtf_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = sqrtf_fw_poly(in[idx]);
+    }
+}
+
+void sinf_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = sinf_fw_poly(in[idx], 0);
+    }
+}
+
+void cosf_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = sinf_fw_poly(in[idx], 1);
+    }
+}
+
+void atanf_fw_v(float* out, const float* in, size_t n)
+{
+    for (size_t idx = 0; idx < n; ++idx)
+    {
+        out[idx] = atanf_fw_poly(in[idx]);
+    }
+}
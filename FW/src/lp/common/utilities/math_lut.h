@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Interpolated lookup tables for dB <-> linear conversion and sine/cosine,
+  fast paths for gain ramps, tone generation and metering.
+*/
+
+#ifndef ADSP_FW_UTILITIES_MATH_LUT_H
+#define ADSP_FW_UTILITIES_MATH_LUT_H
+
+#include "adsp_std_defs.h"
+#include "cpp_backward_compatibility.h"
+#include "math_fw.h"
+
+namespace dsp_fw
+{
+
+enum LutInterpolation
+{
+    // 2 point linear interpolation, error ~ h^2 * f'' / 8
+    LUT_LINEAR = 0,
+    // 4 point Catmull-Rom interpolation, error ~ h^4 * f'''' / 16
+    LUT_CUBIC
+};
+
+/*!
+  \brief Checks at build time that table instance fits into the memory budget.
+  Table size is available as Lut::FOOTPRINT, so it shows up in the error message
+  and can be used in linker map reviews.
+  \note Template arguments contain a comma, pass the table type through a typedef.
+*/
+#define MATH_LUT_ASSERT_FOOTPRINT(Lut, budget_bytes) \
+    static_assert((Lut::FOOTPRINT) <= (budget_bytes), "lookup table exceeds memory budget")
+
+/*!
+  \brief Storage and interpolation kernel shared by lookup tables.
+  Table holds SIZE + 1 points of the function on a uniform grid plus one guard
+  point on each side, so cubic interpolation does not need boundary checks.
+*/
+template <uint32_t SIZE_LOG2, LutInterpolation INTERP>
+class LutTable
+{
+public:
+    static const uint32_t SIZE = 1U << SIZE_LOG2;
+    static const uint32_t FOOTPRINT = (SIZE + 3) * sizeof(float);
+
+    /*!
+      \brief Interpolates between grid points index and index + 1.
+      \param index in [0, SIZE - 1]
+      \param frac in [0, 1]
+    */
+    FORCE_INLINE float Interpolate(uint32_t index, float frac) const
+    {
+        const float* p = &points_[index + 1];
+        if (INTERP == LUT_LINEAR)
+            return p[0] + frac * (p[1] - p[0]);
+
+        const float a = 0.5f * (3.0f * (p[0] - p[1]) + p[2] - p[-1]);
+        const float b = p[-1] - 2.5f * p[0] + 2.0f * p[1] - 0.5f * p[2];
+        const float c = 0.5f * (p[1] - p[-1]);
+        return ((a * frac + b) * frac + c) * frac + p[0];
+    }
+
+protected:
+    // points_[i + 1] = f(grid(i)) for i in [-1, SIZE + 1]
+    float points_[SIZE + 3];
+};
+
+/*!
+  \brief Sine/cosine of phase given as fraction of full turn, 2^32 == 2 * pi,
+  so oscillator phase accumulators wrap for free.
+
+  Max absolute error, float rounding included:
+    size_log2  LUT_LINEAR  LUT_CUBIC
+    8          7.5e-5      6.3e-7
+    10         4.7e-6      4.4e-7
+    12         5.2e-7      4.5e-7
+
+  Example:
+  \code
+      typedef SinCosLut<10, LUT_CUBIC> OscillatorLut;
+      MATH_LUT_ASSERT_FOOTPRINT(OscillatorLut, 4 * 1024 + 64);
+      static OscillatorLut lut;
+      lut.Init();
+      for (i = 0; i < n; ++i, phase += step)
+          out[i] = lut.Sin(phase);
+  \endcode
+*/
+template <uint32_t SIZE_LOG2, LutInterpolation INTERP = LUT_CUBIC>
+class SinCosLut : public LutTable<SIZE_LOG2, INTERP>
+{
+    typedef LutTable<SIZE_LOG2, INTERP> Base;
+    static_assert(SIZE_LOG2 >= 2 && SIZE_LOG2 <= 16, "unsupported sine table size");
+
+public:
+    /*!
+      \brief Fills the table, it takes SIZE + 3 sinf_fw evaluations.
+    */
+    void Init()
+    {
+        const float step = 6.28318530717958648f / Base::SIZE;
+        for (int32_t i = -1; i <= (int32_t)Base::SIZE + 1; ++i)
+            Base::points_[i + 1] = step * i;
+        sinf_fw_v(Base::points_, Base::points_, Base::SIZE + 3);
+    }
+
+    FORCE_INLINE float Sin(uint32_t phase) const
+    {
+        return Base::Interpolate(phase >> (32 - SIZE_LOG2), Fraction(phase));
+    }
+
+    FORCE_INLINE float Cos(uint32_t phase) const
+    {
+        return Sin(phase + QUARTER_TURN);
+    }
+
+    /*!
+      \brief Returns both values sharing the index and fraction computation,
+      cosine is read a quarter of the table ahead.
+    */
+    FORCE_INLINE void SinCos(uint32_t phase, float* sin, float* cos) const
+    {
+        const uint32_t index = phase >> (32 - SIZE_LOG2);
+        const float frac = Fraction(phase);
+        *sin = Base::Interpolate(index, frac);
+        *cos = Base::Interpolate((index + Base::SIZE / 4) & (Base::SIZE - 1), frac);
+    }
+
+    /*!
+      \brief Converts angle in radians to phase, any angle is wrapped to [0, 2 * pi).
+    */
+    static FORCE_INLINE uint32_t PhaseFromRadians(float radians)
+    {
+        // 1 / (2 * pi)
+        const float turns = radians * 0.159154943091895336f;
+        // fraction may round up to 1.0, 64-bit conversion wraps it to 0
+        return (uint32_t)(int64_t)((turns - floorf_fw(turns)) * 4294967296.0f);
+    }
+
+private:
+    static const uint32_t QUARTER_TURN = 1U << 30;
+
+    static FORCE_INLINE float Fraction(uint32_t phase)
+    {
+        // top 24 bits below the index are exact in float
+        return (float)((phase << SIZE_LOG2) >> 8) * (1.0f / 16777216.0f);
+    }
+};
+
+/*!
+  \brief Converts gain in dB to linear scale, input is clamped to [MIN_DB, MAX_DB].
+
+  Max relative error over [-120 dB, 24 dB] (grid step 144 / SIZE dB):
+    size_log2  LUT_LINEAR  LUT_CUBIC
+    8          5.3e-4      5.9e-6
+    10         3.4e-5      1.6e-6
+*/
+template <uint32_t SIZE_LOG2, int32_t MIN_DB, int32_t MAX_DB, LutInterpolation INTERP = LUT_CUBIC>
+class DbToLinearLut : public LutTable<SIZE_LOG2, INTERP>
+{
+    typedef LutTable<SIZE_LOG2, INTERP> Base;
+    static_assert(MIN_DB < MAX_DB, "empty dB range");
+
+public:
+    /*!
+      \brief Fills the table, it takes SIZE + 3 expf_fw evaluations.
+    */
+    void Init()
+    {
+        // ln(10) / 20
+        const float neper_per_db = 0.115129254649702284f;
+        const float step = (float)(MAX_DB - MIN_DB) / Base::SIZE;
+        for (int32_t i = -1; i <= (int32_t)Base::SIZE + 1; ++i)
+            Base::points_[i + 1] = (MIN_DB + step * i) * neper_per_db;
+        expf_fw_v(Base::points_, Base::points_, Base::SIZE + 3);
+    }
+
+    FORCE_INLINE float Convert(float db) const
+    {
+        float position = (db - MIN_DB) * ((float)Base::SIZE / (MAX_DB - MIN_DB));
+        position = max(position, 0.0f);
+        position = min(position, (float)Base::SIZE);
+        uint32_t index = (uint32_t)position;
+        index = min(index, Base::SIZE - 1);
+        return Base::Interpolate(index, position - index);
+    }
+};
+
+/*!
+  \brief Converts linear magnitude to dB.
+
+  Float exponent gives the octave, the table interpolates log2 of the mantissa
+  indexed by its top SIZE_LOG2 bits. Zero, negative and denormal inputs return MIN_DB,
+  results are clamped to MIN_DB from below.
+
+  Max absolute error in dB over [-190 dB, 60 dB], float rounding of large
+  results included:
+    size_log2  LUT_LINEAR  LUT_CUBIC
+    6          2.7e-4      1.2e-5
+    8          2.6e-5      1.2e-5
+*/
+template <uint32_t SIZE_LOG2, int32_t MIN_DB = -200, LutInterpolation INTERP = LUT_CUBIC>
+class LinearToDbLut : public LutTable<SIZE_LOG2, INTERP>
+{
+    typedef LutTable<SIZE_LOG2, INTERP> Base;
+    static_assert(SIZE_LOG2 >= 1 && SIZE_LOG2 <= 16, "unsupported mantissa table size");
+
+public:
+    /*!
+      \brief Fills the table with 20 * log10(1 + i / SIZE), SIZE + 3 logf_fw evaluations.
+    */
+    void Init()
+    {
+        // 20 / ln(10)
+        const float db_per_neper = 8.68588963806503655f;
+        for (int32_t i = -1; i <= (int32_t)Base::SIZE + 1; ++i)
+            Base::points_[i + 1] = 1.0f + (float)i / Base::SIZE;
+        logf_fw_v(Base::points_, Base::points_, Base::SIZE + 3);
+        for (uint32_t i = 0; i < Base::SIZE + 3; ++i)
+            Base::points_[i] *= db_per_neper;
+    }
+
+    FORCE_INLINE float Convert(float linear) const
+    {
+        union { float f; uint32_t u; } bits;
+        bits.f = linear;
+        const int32_t exponent = (int32_t)(bits.u >> 23) - 127;
+        // negative, zero or denormal
+        if ((int32_t)bits.u < (int32_t)0x00800000)
+            return (float)MIN_DB;
+
+        const uint32_t index = (bits.u >> (23 - SIZE_LOG2)) & (Base::SIZE - 1);
+        const float frac = (float)(bits.u & FRAC_MASK) * (1.0f / (FRAC_MASK + 1));
+        // 20 * log10(2)
+        const float db = exponent * 6.02059991327962390f + Base::Interpolate(index, frac);
+        return max(db, (float)MIN_DB);
+    }
+
+private:
+    static const uint32_t FRAC_MASK = (1U << (23 - SIZE_LOG2)) - 1;
+};
+
+} // namespace dsp_fw
+
+#endif // ADSP_FW_UTILITIES_MATH_LUT_H
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef MPUTILS_MPSC_QUEUE_H_
+#define MPUTILS_MPSC_QUEUE_H_
+
+#include "adsp_std_defs.h"
+#include "adsp_assert.h"
+#include "adsp_error.h"
+#include "cpp_backward_compatibility.h"
+#include "platform/memory_defs.h"
+#if !defined(UT)
+#include "sputex.h"
+#endif
+
+namespace MpUtils
+{
+
+/*!
+  \brief Keeps compiler from moving message copies across sequence updates,
+  lines travel between cores as a whole by the explicit cache operations.
+*/
+#define MPSC_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+#if !defined(UT)
+typedef xmp_atomic_int_t MpscCounter;
+
+static FORCE_INLINE void mpsc_counter_init(MpscCounter* counter)
+{
+    xmp_atomic_int_init(counter, 0);
+}
+
+/*!
+  \brief Sets counter to desired if it holds expected, returns previous value.
+*/
+static FORCE_INLINE int mpsc_counter_cas(MpscCounter* counter, int expected, int desired)
+{
+    return xmp_atomic_int_conditional_set(counter, expected, desired);
+}
+
+static FORCE_INLINE int mpsc_counter_load(MpscCounter* counter)
+{
+    return xmp_atomic_int_value(counter);
+}
+#else
+typedef volatile int MpscCounter;
+
+static FORCE_INLINE void mpsc_counter_init(MpscCounter* counter)
+{
+    __sync_lock_test_and_set(counter, 0);
+}
+
+static FORCE_INLINE int mpsc_counter_cas(MpscCounter* counter, int expected, int desired)
+{
+    return __sync_val_compare_and_swap(counter, expected, desired);
+}
+
+static FORCE_INLINE int mpsc_counter_load(MpscCounter* counter)
+{
+    return __sync_fetch_and_add(counter, 0);
+}
+#endif
+
+/*!
+  \brief Bounded lock-free queue of messages for many producers and one consumer,
+  meant for cross-core commands with one instance per destination core.
+
+  Every slot takes exactly one cache line and carries a sequence number next to
+  the message (Vyukov bounded queue): sequence == position means the slot is free
+  for the producer which claimed that position, position + 1 means it holds
+  a message for the consumer. Producers claim positions by compare-and-swap on
+  tail_, the only word touched by more than one core, the consumer owns head_.
+  A message costs one invalidate and one writeback of its slot line on each side,
+  no lock is taken and no other line is touched.
+
+  \note MpscQueue must be aligned to XCHAL_DCACHE_LINESIZE and located in memory
+        visible to all cores, tail_ has the same placement requirements as sputex.
+  \note T is copied with memcpy semantics and has to fit into a slot next to the sequence.
+
+  Example:
+  \code
+      DCACHE_ALIGN static MpscQueue<IpcCommand, 16> core_queues[CORE_COUNT];
+      // any core
+      core_queues[target].Push(command);
+      // target core
+      while (core_queues[xmp_prid()].Pop(&command) == ADSP_SUCCESS) Dispatch(command);
+  \endcode
+*/
+template<class T, uint32_t CAPACITY>
+class MpscQueue
+{
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "capacity has to be power of two");
+
+public:
+    MpscQueue()
+    {
+        Reset();
+    }
+
+    /*!
+      \brief Drops all messages, must not race with Push() or Pop().
+    */
+    void Reset()
+    {
+        assert(IS_ALIGNED(this, XCHAL_DCACHE_LINESIZE));
+        for (uint32_t i = 0; i < CAPACITY; ++i)
+            slots_[i].sequence = i;
+        arch_cpu_dcache_region_writeback_inv(slots_, sizeof(slots_));
+        head_ = 0;
+        mpsc_counter_init(&tail_);
+    }
+
+    /*!
+      \brief Copies message into the queue, may be called from any core concurrently.
+      \return ADSP_SUCCESS
+      \return ADSP_SIMPLE_QUEUE_FULL when consumer has not released the slot yet
+    */
+    ErrorCode Push(const T& message)
+    {
+        uint32_t position = (uint32_t)mpsc_counter_load(&tail_);
+        Slot* slot;
+        for (;;)
+        {
+            slot = &slots_[position & (CAPACITY - 1)];
+            arch_cpu_dcache_region_invalidate(slot, sizeof(Slot));
+            const int32_t diff = (int32_t)(slot->sequence - position);
+            if (diff == 0)
+            {
+                const uint32_t observed = (uint32_t)mpsc_counter_cas(&tail_, (int)position, (int)(position + 1));
+                if (observed == position)
+                    break;
+                position = observed;
+            }
+            else if (diff < 0)
+            {
+                return ADSP_SIMPLE_QUEUE_FULL;
+            }
+            else
+            {
+                // other producer claimed this position already
+                position = (uint32_t)mpsc_counter_load(&tail_);
+            }
+        }
+        slot->message = message;
+        MPSC_QUEUE_BARRIER();
+        slot->sequence = position + 1;
+        arch_cpu_dcache_region_writeback_inv(slot, sizeof(Slot));
+        return ADSP_SUCCESS;
+    }
+
+    /*!
+      \brief Copies the oldest message out of the queue, consumer core only.
+      \return ADSP_SUCCESS
+      \return ADSP_SIMPLE_QUEUE_EMPTY when there is no complete message
+    */
+    ErrorCode Pop(T* message)
+    {
+        const uint32_t position = head_;
+        Slot* slot = &slots_[position & (CAPACITY - 1)];
+        arch_cpu_dcache_region_invalidate(slot, sizeof(Slot));
+        if (slot->sequence != position + 1)
+            return ADSP_SIMPLE_QUEUE_EMPTY;
+        MPSC_QUEUE_BARRIER();
+        *message = slot->message;
+        MPSC_QUEUE_BARRIER();
+        // hand the slot over to producers of the next round
+        slot->sequence = position + CAPACITY;
+        arch_cpu_dcache_region_writeback_inv(slot, sizeof(Slot));
+        head_ = position + 1;
+        return ADSP_SUCCESS;
+    }
+
+private:
+    struct Slot
+    {
+        // alignment pads the slot to a full line
+        DCACHE_ALIGN volatile uint32_t sequence;
+        T message;
+    };
+    static_assert(sizeof(Slot) == XCHAL_DCACHE_LINESIZE, "message does not fit into one cache line slot");
+
+    Slot slots_[CAPACITY];
+    // positions claimed by producers, shared by all cores
+    DCACHE_ALIGN MpscCounter tail_;
+    // next position to consume, touched by consumer only
+    DCACHE_ALIGN uint32_t head_;
+};
+
+} // namespace MpUtils
+
+#endif // MPUTILS_MPSC_QUEUE_H_
@@ -0,0 +1,499 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#include <adsp_s_memory.h>
+#include "polyphase_src.h"
+
+namespace dsp_fw
+{
+
+/*
+ * Kaiser windowed sinc prototypes, Q1.15.
+ * Each table holds (phases + 1) rows, row p is prototype decimated by phases starting at p.
+ * dec3/int3 share 48k prototype with cutoff at 7.2 kHz (gain 1 and 3 respectively),
+ * fractional tables have cutoff at 0.42 of source rate.
+ */
+static const int16_t src_dec3_coefs[(1 + 1) * 48] = {
+         0,      2,     11,     16,      0,    -38,    -64,    -29,
+        75,    171,    131,    -89,   -349,   -375,      0,    585,
+       857,    348,   -832,  -1810,  -1400,   1021,   4849,   8391,
+      9830,   8391,   4849,   1021,  -1400,  -1810,   -832,    348,
+       857,    585,      0,   -375,   -349,    -89,    131,    171,
+        75,    -29,    -64,    -38,      0,     16,     11,      2,
+         2,     11,     16,      0,    -38,    -64,    -29,     75,
+       171,    131,    -89,   -349,   -375,      0,    585,    857,
+       348,   -832,  -1810,  -1400,   1021,   4849,   8391,   9830,
+      8391,   4849,   1021,  -1400,  -1810,   -832,    348,    857,
+       585,      0,   -375,   -349,    -89,    131,    171,     75,
+       -29,    -64,    -38,      0,     16,     11,      2,      0
+};
+
+static const int16_t src_int3_coefs[(3 + 1) * 16] = {
+         0,     48,   -192,    512,  -1047,   1756,  -2496,   3064,
+     29491,   3064,  -2496,   1756,  -1047,    512,   -192,     48,
+         6,      0,    -87,    394,  -1124,   2571,  -5430,  14548,
+     25173,  -4200,   1043,      0,   -267,    226,   -114,     33,
+        33,   -114,    226,   -267,      0,   1043,  -4200,  25173,
+     14548,  -5430,   2571,  -1124,    394,    -87,      0,      6,
+        48,   -192,    512,  -1047,   1756,  -2496,   3064,  29491,
+      3064,  -2496,   1756,  -1047,    512,   -192,     48,      0
+};
+
+static const int16_t src_frac_low_coefs[(32 + 1) * 16] = {
+         0,    -37,    -36,    375,  -1139,   2331,  -3702,   4814,
+     27525,   4814,  -3702,   2331,  -1139,    375,    -36,    -37,
+        17,    -46,    -13,    339,  -1113,   2380,  -3966,   5712,
+     27493,   3942,  -3423,   2267,  -1156,    407,    -57,    -28,
+        19,    -56,     12,    298,  -1078,   2413,  -4213,   6633,
+     27396,   3099,  -3132,   2190,  -1164,    434,    -77,    -20,
+        22,    -66,     38,    254,  -1033,   2431,  -4440,   7574,
+     27235,   2287,  -2831,   2101,  -1164,    457,    -95,    -12,
+        24,    -76,     64,    205,   -979,   2431,  -4645,   8532,
+     27011,   1510,  -2522,   2000,  -1155,    476,   -112,     -4,
+        26,    -86,     92,    153,   -915,   2413,  -4826,   9503,
+     26724,    768,  -2208,   1889,  -1138,    490,   -126,      3,
+        28,    -96,    121,     97,   -843,   2377,  -4980,  10484,
+     26376,     65,  -1892,   1768,  -1114,    500,   -139,      9,
+        31,   -106,    150,     38,   -760,   2323,  -5104,  11470,
+     25968,   -598,  -1575,   1640,  -1083,    506,   -150,     15,
+        33,   -116,    180,    -24,   -670,   2250,  -5198,  12459,
+     25503,  -1221,  -1260,   1505,  -1045,    508,   -159,     20,
+        35,   -125,    210,    -89,   -570,   2157,  -5258,  13447,
+     24982,  -1800,   -948,   1364,  -1002,    506,   -167,     25,
+        36,   -134,    240,   -156,   -462,   2045,  -5283,  14429,
+     24407,  -2335,   -642,   1219,   -953,    501,   -173,     29,
+        38,   -143,    270,   -224,   -347,   1914,  -5271,  15402,
+     23782,  -2826,   -343,   1071,   -899,    492,   -177,     32,
+        39,   -151,    299,   -294,   -225,   1764,  -5220,  16361,
+     23108,  -3272,    -54,    921,   -841,    480,   -179,     35,
+        40,   -158,    327,   -365,    -96,   1595,  -5128,  17304,
+     22389,  -3672,    225,    770,   -779,    465,   -180,     37,
+        41,   -165,    354,   -436,     39,   1407,  -4996,  18225,
+     21627,  -4027,    491,    619,   -714,    447,   -180,     39,
+        41,   -170,    380,   -508,    179,   1203,  -4820,  19122,
+     20827,  -4336,    743,    470,   -647,    427,   -178,     40,
+        41,   -174,    404,   -578,    323,    981,  -4600,  19990,
+     19990,  -4600,    981,    323,   -578,    404,   -174,     41,
+        40,   -178,    427,   -647,    470,    743,  -4336,  20827,
+     19122,  -4820,   1203,    179,   -508,    380,   -170,     41,
+        39,   -180,    447,   -714,    619,    491,  -4027,  21627,
+     18225,  -4996,   1407,     39,   -436,    354,   -165,     41,
+        37,   -180,    465,   -779,    770,    225,  -3672,  22389,
+     17304,  -5128,   1595,    -96,   -365,    327,   -158,     40,
+        35,   -179,    480,   -841,    921,    -54,  -3272,  23108,
+     16361,  -5220,   1764,   -225,   -294,    299,   -151,     39,
+        32,   -177,    492,   -899,   1071,   -343,  -2826,  23782,
+     15402,  -5271,   1914,   -347,   -224,    270,   -143,     38,
+        29,   -173,    501,   -953,   1219,   -642,  -2335,  24407,
+     14429,  -5283,   2045,   -462,   -156,    240,   -134,     36,
+        25,   -167,    506,  -1002,   1364,   -948,  -1800,  24982,
+     13447,  -5258,   2157,   -570,    -89,    210,   -125,     35,
+        20,   -159,    508,  -1045,   1505,  -1260,  -1221,  25503,
+     12459,  -5198,   2250,   -670,    -24,    180,   -116,     33,
+        15,   -150,    506,  -1083,   1640,  -1575,   -598,  25968,
+     11470,  -5104,   2323,   -760,     38,    150,   -106,     31,
+         9,   -139,    500,  -1114,   1768,  -1892,     65,  26376,
+     10484,  -4980,   2377,   -843,     97,    121,    -96,     28,
+         3,   -126,    490,  -1138,   1889,  -2208,    768,  26724,
+      9503,  -4826,   2413,   -915,    153,     92,    -86,     26,
+        -4,   -112,    476,  -1155,   2000,  -2522,   1510,  27011,
+      8532,  -4645,   2431,   -979,    205,     64,    -76,     24,
+       -12,    -95,    457,  -1164,   2101,  -2831,   2287,  27235,
+      7574,  -4440,   2431,  -1033,    254,     38,    -66,     22,
+       -20,    -77,    434,  -1164,   2190,  -3132,   3099,  27396,
+      6633,  -4213,   2413,  -1078,    298,     12,    -56,     19,
+       -28,    -57,    407,  -1156,   2267,  -3423,   3942,  27493,
+      5712,  -3966,   2380,  -1113,    339,    -13,    -46,     17,
+       -37,    -36,    375,  -1139,   2331,  -3702,   4814,  27525,
+      4814,  -3702,   2331,  -1139,    375,    -36,    -37,      0
+};
+
+static const int16_t src_frac_high_coefs[(32 + 1) * 32] = {
+         0,      6,    -12,      9,     18,    -86,    195,   -314,
+       371,   -259,   -126,    844,  -1861,   3039,  -4152,   4952,
+     27525,   4952,  -4152,   3039,  -1861,    844,   -126,   -259,
+       371,   -314,    195,    -86,     18,      9,    -12,      6,
+        -2,      7,    -13,     13,     12,    -79,    192,   -323,
+       400,   -315,    -44,    753,  -1803,   3085,  -4433,   5865,
+     27494,   4062,  -3854,   2974,  -1905,    926,   -206,   -202,
+       340,   -304,    197,    -92,     23,      6,    -11,      6,
+        -2,      7,    -15,     16,      6,    -72,    187,   -329,
+       426,   -371,     40,    656,  -1732,   3111,  -4692,   6800,
+     27399,   3199,  -3539,   2890,  -1934,   1000,   -283,   -145,
+       308,   -292,    197,    -96,     28,      3,     -9,      6,
+        -2,      7,    -16,     19,      0,    -64,    181,   -332,
+       451,   -425,    127,    552,  -1646,   3115,  -4928,   7752,
+     27242,   2366,  -3211,   2788,  -1950,   1066,   -356,    -88,
+       274,   -279,    196,   -101,     33,      0,     -8,      5,
+        -2,      8,    -17,     23,     -6,    -55,    174,   -334,
+       473,   -478,    214,    441,  -1547,   3098,  -5137,   8719,
+     27022,   1565,  -2872,   2670,  -1952,   1124,   -424,    -32,
+       239,   -264,    193,   -104,     37,     -3,     -7,      5,
+        -2,      8,    -18,     26,    -13,    -46,    165,   -333,
+       492,   -529,    301,    325,  -1435,   3059,  -5319,   9696,
+     26742,    798,  -2525,   2537,  -1941,   1172,   -489,     23,
+       204,   -247,    190,   -106,     40,     -5,     -5,      4,
+        -2,      8,    -20,     29,    -19,    -35,    154,   -330,
+       508,   -577,    389,    204,  -1311,   2998,  -5470,  10681,
+     26402,     68,  -2172,   2390,  -1917,   1211,   -549,     77,
+       168,   -229,    185,   -108,     44,     -8,     -4,      4,
+        -2,      8,    -21,     32,    -26,    -25,    143,   -325,
+       520,   -622,    476,     79,  -1174,   2914,  -5589,  11670,
+     26003,   -624,  -1815,   2231,  -1880,   1241,   -603,    129,
+       131,   -210,    179,   -108,     46,    -10,     -3,      3,
+        -2,      8,    -21,     35,    -33,    -13,    129,   -317,
+       530,   -663,    561,    -49,  -1025,   2807,  -5673,  12659,
+     25548,  -1276,  -1458,   2060,  -1831,   1262,   -652,    179,
+        95,   -190,    172,   -108,     49,    -13,     -1,      3,
+        -2,      8,    -22,     38,    -40,     -2,    115,   -306,
+       536,   -701,    644,   -180,   -866,   2677,  -5721,  13644,
+     25038,  -1886,  -1102,   1879,  -1771,   1274,   -696,    226,
+        59,   -169,    163,   -108,     51,    -15,      0,      2,
+        -1,      8,    -23,     41,    -47,     10,     99,   -293,
+       538,   -735,    725,   -313,   -697,   2525,  -5730,  14623,
+     24475,  -2452,   -749,   1691,  -1700,   1277,   -734,    271,
+        23,   -148,    154,   -106,     52,    -16,      1,      2,
+        -1,      8,    -23,     44,    -54,     23,     82,   -278,
+       537,   -765,    802,   -446,   -520,   2351,  -5700,  15590,
+     23861,  -2975,   -402,   1495,  -1619,   1271,   -766,    313,
+       -12,   -126,    145,   -104,     53,    -18,      2,      2,
+        -1,      8,    -24,     46,    -60,     35,     64,   -261,
+       532,   -790,    876,   -579,   -334,   2156,  -5628,  16542,
+     23200,  -3453,    -63,   1294,  -1529,   1256,   -792,    352,
+       -45,   -104,    134,   -101,     54,    -19,      3,      1,
+        -1,      7,    -24,     48,    -67,     48,     45,   -241,
+       523,   -809,    945,   -712,   -141,   1940,  -5514,  17477,
+     22493,  -3885,    266,   1089,  -1430,   1233,   -812,    387,
+       -78,    -82,    123,    -98,     54,    -21,      4,      1,
+        -1,      7,    -24,     50,    -73,     61,     26,   -218,
+       510,   -824,   1008,   -842,     57,   1704,  -5355,  18388,
+     21744,  -4271,    583,    882,  -1324,   1203,   -827,    419,
+      -110,    -60,    111,    -94,     54,    -22,      5,      0,
+         0,      7,    -24,     52,    -78,     74,      5,   -194,
+       493,   -833,   1067,   -969,    260,   1449,  -5153,  19275,
+     20956,  -4611,    887,    674,  -1211,   1164,   -835,    447,
+      -140,    -38,     99,    -89,     54,    -23,      5,      0,
+         0,      6,    -23,     53,    -84,     87,    -16,   -168,
+       472,   -837,   1119,  -1093,    466,   1176,  -4905,  20132,
+     20132,  -4905,   1176,    466,  -1093,   1119,   -837,    472,
+      -168,    -16,     87,    -84,     53,    -23,      6,      0,
+         0,      5,    -23,     54,    -89,     99,    -38,   -140,
+       447,   -835,   1164,  -1211,    674,    887,  -4611,  20956,
+     19275,  -5153,   1449,    260,   -969,   1067,   -833,    493,
+      -194,      5,     74,    -78,     52,    -24,      7,      0,
+         0,      5,    -22,     54,    -94,    111,    -60,   -110,
+       419,   -827,   1203,  -1324,    882,    583,  -4271,  21744,
+     18388,  -5355,   1704,     57,   -842,   1008,   -824,    510,
+      -218,     26,     61,    -73,     50,    -24,      7,     -1,
+         1,      4,    -21,     54,    -98,    123,    -82,    -78,
+       387,   -812,   1233,  -1430,   1089,    266,  -3885,  22493,
+     17477,  -5514,   1940,   -141,   -712,    945,   -809,    523,
+      -241,     45,     48,    -67,     48,    -24,      7,     -1,
+         1,      3,    -19,     54,   -101,    134,   -104,    -45,
+       352,   -792,   1256,  -1529,   1294,    -63,  -3453,  23200,
+     16542,  -5628,   2156,   -334,   -579,    876,   -790,    532,
+      -261,     64,     35,    -60,     46,    -24,      8,     -1,
+         2,      2,    -18,     53,   -104,    145,   -126,    -12,
+       313,   -766,   1271,  -1619,   1495,   -402,  -2975,  23861,
+     15590,  -5700,   2351,   -520,   -446,    802,   -765,    537,
+      -278,     82,     23,    -54,     44,    -23,      8,     -1,
+         2,      1,    -16,     52,   -106,    154,   -148,     23,
+       271,   -734,   1277,  -1700,   1691,   -749,  -2452,  24475,
+     14623,  -5730,   2525,   -697,   -313,    725,   -735,    538,
+      -293,     99,     10,    -47,     41,    -23,      8,     -1,
+         2,      0,    -15,     51,   -108,    163,   -169,     59,
+       226,   -696,   1274,  -1771,   1879,  -1102,  -1886,  25038,
+     13644,  -5721,   2677,   -866,   -180,    644,   -701,    536,
+      -306,    115,     -2,    -40,     38,    -22,      8,     -2,
+         3,     -1,    -13,     49,   -108,    172,   -190,     95,
+       179,   -652,   1262,  -1831,   2060,  -1458,  -1276,  25548,
+     12659,  -5673,   2807,  -1025,    -49,    561,   -663,    530,
+      -317,    129,    -13,    -33,     35,    -21,      8,     -2,
+         3,     -3,    -10,     46,   -108,    179,   -210,    131,
+       129,   -603,   1241,  -1880,   2231,  -1815,   -624,  26003,
+     11670,  -5589,   2914,  -1174,     79,    476,   -622,    520,
+      -325,    143,    -25,    -26,     32,    -21,      8,     -2,
+         4,     -4,     -8,     44,   -108,    185,   -229,    168,
+        77,   -549,   1211,  -1917,   2390,  -2172,     68,  26402,
+     10681,  -5470,   2998,  -1311,    204,    389,   -577,    508,
+      -330,    154,    -35,    -19,     29,    -20,      8,     -2,
+         4,     -5,     -5,     40,   -106,    190,   -247,    204,
+        23,   -489,   1172,  -1941,   2537,  -2525,    798,  26742,
+      9696,  -5319,   3059,  -1435,    325,    301,   -529,    492,
+      -333,    165,    -46,    -13,     26,    -18,      8,     -2,
+         5,     -7,     -3,     37,   -104,    193,   -264,    239,
+       -32,   -424,   1124,  -1952,   2670,  -2872,   1565,  27022,
+      8719,  -5137,   3098,  -1547,    441,    214,   -478,    473,
+      -334,    174,    -55,     -6,     23,    -17,      8,     -2,
+         5,     -8,      0,     33,   -101,    196,   -279,    274,
+       -88,   -356,   1066,  -1950,   2788,  -3211,   2366,  27242,
+      7752,  -4928,   3115,  -1646,    552,    127,   -425,    451,
+      -332,    181,    -64,      0,     19,    -16,      7,     -2,
+         6,     -9,      3,     28,    -96,    197,   -292,    308,
+      -145,   -283,   1000,  -1934,   2890,  -3539,   3199,  27399,
+      6800,  -4692,   3111,  -1732,    656,     40,   -371,    426,
+      -329,    187,    -72,      6,     16,    -15,      7,     -2,
+         6,    -11,      6,     23,    -92,    197,   -304,    340,
+      -202,   -206,    926,  -1905,   2974,  -3854,   4062,  27494,
+      5865,  -4433,   3085,  -1803,    753,    -44,   -315,    400,
+      -323,    192,    -79,     12,     13,    -13,      7,     -2,
+         6,    -12,      9,     18,    -86,    195,   -314,    371,
+      -259,   -126,    844,  -1861,   3039,  -4152,   4952,  27525,
+      4952,  -4152,   3039,  -1861,    844,   -126,   -259,    371,
+      -314,    195,    -86,     18,      9,    -12,      6,      0
+};
+
+#define SRC_DRIFT_PPM_SCALE 1000000
+
+struct SrcPresetDesc
+{
+    uint32_t ratio_l;
+    uint32_t ratio_m;
+    bool fractional;
+};
+
+// ratio is output/input rate
+static const SrcPresetDesc src_presets[PolyphaseSrc::SRC_PRESETS_COUNT] =
+{
+    { 1, 3, false },      // SRC_48K_TO_16K
+    { 3, 1, false },      // SRC_16K_TO_48K
+    { 160, 147, true },   // SRC_44K1_TO_48K
+    { 147, 160, true },   // SRC_48K_TO_44K1
+    { 1, 1, true },       // SRC_48K_TO_48K
+};
+
+static FORCE_INLINE int32_t sat_q31(int64_t value)
+{
+    if (value > INT32_MAX) return INT32_MAX;
+    if (value < INT32_MIN) return INT32_MIN;
+    return (int32_t)value;
+}
+
+/*!
+  \brief Inner product of newest-first history with single filter phase, Q1.31 result.
+*/
+static FORCE_INLINE int32_t fir_q31_q15(const int32_t* history, const int16_t* coefs, uint32_t taps)
+{
+    int64_t acc = 1 << 14;
+    for (uint32_t k = 0; k < taps; ++k)
+    {
+        acc += (int64_t)history[k] * coefs[k];
+    }
+    return sat_q31(acc >> 15);
+}
+
+static FORCE_INLINE int32_t load_q31(const uint8_t*& in, PolyphaseSrc::Format format)
+{
+    int32_t value;
+    switch (format)
+    {
+    case PolyphaseSrc::SRC_FORMAT_16B:
+        value = (int32_t)((uint32_t)(uint16_t)*(const int16_t*)in << 16);
+        in += sizeof(int16_t);
+        break;
+    case PolyphaseSrc::SRC_FORMAT_24B:
+        value = (int32_t)(((uint32_t)in[0] << 8) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 24));
+        in += 3;
+        break;
+    default:
+        value = *(const int32_t*)in;
+        in += sizeof(int32_t);
+        break;
+    }
+    return value;
+}
+
+static FORCE_INLINE void store_q31(uint8_t*& out, PolyphaseSrc::Format format, int32_t value)
+{
+    switch (format)
+    {
+    case PolyphaseSrc::SRC_FORMAT_16B:
+        *(int16_t*)out = (int16_t)(sat_q31((int64_t)value + (1 << 15)) >> 16);
+        out += sizeof(int16_t);
+        break;
+    case PolyphaseSrc::SRC_FORMAT_24B:
+        value = sat_q31((int64_t)value + (1 << 7)) >> 8;
+        out[0] = (uint8_t)value;
+        out[1] = (uint8_t)(value >> 8);
+        out[2] = (uint8_t)(value >> 16);
+        out += 3;
+        break;
+    default:
+        *(int32_t*)out = value;
+        out += sizeof(int32_t);
+        break;
+    }
+}
+
+PolyphaseSrc::PolyphaseSrc() :
+    channels_(0),
+    in_format_(SRC_FORMAT_32B),
+    out_format_(SRC_FORMAT_32B),
+    fractional_(false),
+    ratio_l_(1),
+    ratio_m_(1),
+    phase_(0),
+    phase_rem_(0),
+    step_(0),
+    step_rem_(0),
+    step_den_(1),
+    history_pos_(0)
+{
+    filter_.coefs = NULL;
+    filter_.phases = 0;
+    filter_.taps = 0;
+}
+
+ErrorCode PolyphaseSrc::Init(Preset preset, Quality quality, size_t channels, Format in_format, Format out_format)
+{
+    RETURN_EC_ON_FAIL(preset < SRC_PRESETS_COUNT, ADSP_ERROR_INVALID_PARAM);
+    RETURN_EC_ON_FAIL(quality <= SRC_QUALITY_HIGH, ADSP_ERROR_INVALID_PARAM);
+    RETURN_EC_ON_FAIL(channels != 0 && channels <= MAX_CHANNELS, ADSP_ERROR_INVALID_PARAM);
+    RETURN_EC_ON_FAIL(in_format <= SRC_FORMAT_32B && out_format <= SRC_FORMAT_32B, ADSP_ERROR_INVALID_PARAM);
+
+    const SrcPresetDesc& desc = src_presets[preset];
+    if (desc.fractional)
+    {
+        filter_.phases = 32;
+        if (quality == SRC_QUALITY_HIGH)
+        {
+            filter_.coefs = src_frac_high_coefs;
+            filter_.taps = 32;
+        }
+        else
+        {
+            filter_.coefs = src_frac_low_coefs;
+            filter_.taps = 16;
+        }
+    }
+    else if (desc.ratio_l > desc.ratio_m)
+    {
+        filter_.coefs = src_int3_coefs;
+        filter_.phases = 3;
+        filter_.taps = 16;
+    }
+    else
+    {
+        filter_.coefs = src_dec3_coefs;
+        filter_.phases = 1;
+        filter_.taps = 48;
+    }
+    assert(filter_.taps <= MAX_TAPS);
+
+    channels_ = channels;
+    in_format_ = in_format;
+    out_format_ = out_format;
+    fractional_ = desc.fractional;
+    ratio_l_ = desc.ratio_l;
+    ratio_m_ = desc.ratio_m;
+
+    Reset();
+    return SetDrift(0);
+}
+
+void PolyphaseSrc::Reset()
+{
+    memset(history_, 0, sizeof(history_));
+    history_pos_ = 0;
+    phase_ = 0;
+    phase_rem_ = 0;
+}
+
+ErrorCode PolyphaseSrc::SetDrift(int32_t drift_ppm)
+{
+    RETURN_EC_ON_FAIL(filter_.coefs != NULL, ADSP_INVALID_REQUEST);
+    RETURN_EC_ON_FAIL(fractional_ || drift_ppm == 0, ADSP_INVALID_REQUEST);
+    RETURN_EC_ON_FAIL(drift_ppm > -SRC_DRIFT_PPM_SCALE / 2 && drift_ppm < SRC_DRIFT_PPM_SCALE / 2,
+                      ADSP_ERROR_INVALID_PARAM);
+
+    // step = M/L source frames per output frame in Q16 phase units, kept as exact fraction
+    const uint64_t num = (uint64_t)ratio_m_ * (filter_.phases << 16) * (SRC_DRIFT_PPM_SCALE + drift_ppm);
+    const uint64_t den = (uint64_t)ratio_l_ * SRC_DRIFT_PPM_SCALE;
+    step_ = (uint32_t)(num / den);
+    step_rem_ = (uint32_t)(num % den);
+    step_den_ = (uint32_t)den;
+    if (phase_rem_ >= step_den_)
+    {
+        phase_rem_ = 0;
+    }
+    return ADSP_SUCCESS;
+}
+
+size_t PolyphaseSrc::GetMaxOutputFrames(size_t in_frames) const
+{
+    if (step_ == 0)
+        return 0;
+    // step_ is rounded down, so it gives an upper bound
+    return (size_t)(((uint64_t)in_frames * (filter_.phases << 16)) / step_) + 1;
+}
+
+ErrorCode PolyphaseSrc::Process(const void* in, size_t in_frames, void* out, size_t out_capacity, size_t* out_frames)
+{
+    RETURN_EC_ON_FAIL(in != NULL && out != NULL && out_frames != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
+    RETURN_EC_ON_FAIL(filter_.coefs != NULL, ADSP_INVALID_REQUEST);
+    RETURN_EC_ON_FAIL(out_capacity >= GetMaxOutputFrames(in_frames), ADSP_OUT_OF_RESOURCES);
+
+    const uint32_t one_frame = filter_.phases << 16;
+    const uint8_t* rd = (const uint8_t*)in;
+    uint8_t* wr = (uint8_t*)out;
+    size_t produced = 0;
+
+    for (size_t frame = 0; frame < in_frames; ++frame)
+    {
+        PushFrame(rd);
+        while (phase_ < one_frame)
+        {
+            EmitFrame(wr);
+            Advance();
+            produced++;
+        }
+        phase_ -= one_frame;
+    }
+    *out_frames = produced;
+    return ADSP_SUCCESS;
+}
+
+void PolyphaseSrc::PushFrame(const uint8_t*& in)
+{
+    const uint32_t taps = filter_.taps;
+    history_pos_ = (history_pos_ == 0) ? taps - 1 : history_pos_ - 1;
+    for (size_t ch = 0; ch < channels_; ++ch)
+    {
+        const int32_t sample = load_q31(in, in_format_);
+        history_[ch][history_pos_] = sample;
+        history_[ch][history_pos_ + taps] = sample;
+    }
+}
+
+void PolyphaseSrc::EmitFrame(uint8_t*& out)
+{
+    const uint32_t taps = filter_.taps;
+    const int16_t* coefs = filter_.coefs + (phase_ >> 16) * taps;
+    const int32_t frac = phase_ & 0xFFFF;
+    for (size_t ch = 0; ch < channels_; ++ch)
+    {
+        const int32_t* history = &history_[ch][history_pos_];
+        int32_t value = fir_q31_q15(history, coefs, taps);
+        if (frac != 0)
+        {
+            // linear interpolation towards the next filter phase
+            const int32_t next = fir_q31_q15(history, coefs + taps, taps);
+            value += (int32_t)((((int64_t)next - value) * frac) >> 16);
+        }
+        store_q31(out, out_format_, value);
+    }
+}
+
+void PolyphaseSrc::Advance()
+{
+    phase_ += step_;
+    phase_rem_ += step_rem_;
+    if (phase_rem_ >= step_den_)
+    {
+        phase_rem_ -= step_den_;
+        phase_ += 1;
+    }
+}
+
+} // namespace dsp_fw
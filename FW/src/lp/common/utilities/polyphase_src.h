@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Polyphase FIR sample rate converter.
+*/
+
+#ifndef ADSP_FW_UTILITIES_POLYPHASE_SRC_H
+#define ADSP_FW_UTILITIES_POLYPHASE_SRC_H
+
+#include "adsp_std_defs.h"
+#include "adsp_error.h"
+
+namespace dsp_fw
+{
+
+/*!
+  \brief PolyphaseSrc converts interleaved multichannel stream between common sample rates.
+
+  Filtering is done on Q1.31 samples with Q1.15 coefficients taken from precomputed
+  polyphase tables. Output phase is tracked by an exact rational accumulator, so fixed
+  ratios (e.g. 160/147 for 44.1k -> 48k) do not drift. Fractional presets interpolate
+  between adjacent filter phases, which lets the ratio be adjusted by SetDrift()
+  to follow clock drift between source and sink.
+
+  Source and destination sample formats are the ones handled by converters.h.
+
+  Example:
+  \code
+      PolyphaseSrc src;
+      src.Init(PolyphaseSrc::SRC_44K1_TO_48K, PolyphaseSrc::SRC_QUALITY_HIGH, 2,
+               PolyphaseSrc::SRC_FORMAT_16B, PolyphaseSrc::SRC_FORMAT_32B);
+      size_t produced = 0;
+      src.Process(in, in_frames, out, src.GetMaxOutputFrames(in_frames), &produced);
+  \endcode
+*/
+class PolyphaseSrc
+{
+public:
+    static const size_t MAX_CHANNELS = 8;
+    static const size_t MAX_TAPS = 48;
+
+    enum Preset
+    {
+        SRC_48K_TO_16K = 0,
+        SRC_16K_TO_48K,
+        SRC_44K1_TO_48K,
+        SRC_48K_TO_44K1,
+        // 1:1 ratio, used for drift correction only
+        SRC_48K_TO_48K,
+        SRC_PRESETS_COUNT
+    };
+
+    /*!
+      \brief Quality/cost trade-off of the fractional presets
+      (16 or 32 taps per output sample, two filter phases are evaluated per output).
+      Integer ratio presets always use single 48 tap filter phase per output.
+    */
+    enum Quality
+    {
+        SRC_QUALITY_LOW = 0,
+        SRC_QUALITY_HIGH
+    };
+
+    enum Format
+    {
+        // 16-bit samples
+        SRC_FORMAT_16B = 0,
+        // 24-bit packed samples
+        SRC_FORMAT_24B,
+        // 32-bit samples (also 24-bit MSB aligned in 32-bit container)
+        SRC_FORMAT_32B
+    };
+
+    PolyphaseSrc();
+
+    /*!
+      \brief Initializes converter and clears filter history.
+      \return ADSP_SUCCESS
+      \return ADSP_ERROR_INVALID_PARAM on unsupported preset, quality, format or channel count
+    */
+    ErrorCode Init(Preset preset, Quality quality, size_t channels, Format in_format, Format out_format);
+
+    /*!
+      \brief Clears filter history and output phase.
+    */
+    void Reset();
+
+    /*!
+      \brief Adjusts conversion ratio of fractional presets by drift_ppm
+      (positive value makes the output shorter, i.e. consumes source faster).
+      \return ADSP_INVALID_REQUEST for integer ratio presets
+    */
+    ErrorCode SetDrift(int32_t drift_ppm);
+
+    /*!
+      \brief Upper bound of number of frames produced from in_frames.
+    */
+    size_t GetMaxOutputFrames(size_t in_frames) const;
+
+    /*!
+      \brief Converts in_frames of interleaved source.
+      \param in          source samples in in_format
+      \param in_frames   number of source frames
+      \param out         destination for samples in out_format
+      \param out_capacity capacity of out in frames, must not be lower than GetMaxOutputFrames(in_frames)
+      \param out_frames  <out> number of frames produced
+    */
+    ErrorCode Process(const void* in, size_t in_frames, void* out, size_t out_capacity, size_t* out_frames);
+
+private:
+    struct Filter
+    {
+        // (phases + 1) rows of taps coefficients, last row is phase 0 delayed by single tap
+        const int16_t* coefs;
+        uint32_t phases;
+        uint32_t taps;
+    };
+
+    void PushFrame(const uint8_t*& in);
+    void EmitFrame(uint8_t*& out);
+    void Advance();
+
+    Filter filter_;
+    size_t channels_;
+    Format in_format_;
+    Format out_format_;
+    bool fractional_;
+
+    // rate ratio L/M (output/input)
+    uint32_t ratio_l_;
+    uint32_t ratio_m_;
+
+    // output phase in Q16 units of filter phase, one source frame is filter_.phases << 16
+    uint32_t phase_;
+    uint32_t phase_rem_;
+    uint32_t step_;
+    uint32_t step_rem_;
+    uint32_t step_den_;
+
+    // history duplicated in both halves so newest-first window is always contiguous
+    int32_t history_[MAX_CHANNELS][2 * MAX_TAPS];
+    uint32_t history_pos_;
+};
+
+} // namespace dsp_fw
+
+#endif // ADSP_FW_UTILITIES_POLYPHASE_SRC_H
@@ -6,17 +6,78 @@
 #include "adsp_std_defs.h"
 #include "queue.h"
 
+// address of this object marks removed slots, it never equals a pushed element
+static const uint8_t queue_tombstone = 0;
+#define QUEUE_TOMBSTONE ((const void*)&queue_tombstone)
+
+static FORCE_INLINE uint32_t QueueNextIndex(const SimpleQueue* queue, uint32_t index)
+{
+    return (index + 1 == queue->size) ? 0 : index + 1;
+}
+
+/*!
+  \brief Releases tombstones at the front, so front points at live element or rear.
+*/
+static FORCE_INLINE void QueueDropFrontTombstones(SimpleQueue* queue)
+{
+    while (queue->tombstones_count != 0 && queue->elements_array[queue->front] == QUEUE_TOMBSTONE)
+    {
+        queue->elements_array[queue->front] = NULL;
+        queue->front = QueueNextIndex(queue, queue->front);
+        --queue->tombstones_count;
+    }
+}
+
+/*!
+  \brief Moves live elements towards front over tombstones, keeps their order.
+*/
+static void QueueCompact(SimpleQueue* queue)
+{
+    const uint32_t occupied = queue->elements_count + queue->tombstones_count;
+    uint32_t write = queue->front;
+    uint32_t read = queue->front;
+    for (uint32_t i = 0; i < occupied; ++i)
+    {
+        const void* element = queue->elements_array[read];
+        if (element != QUEUE_TOMBSTONE)
+        {
+            queue->elements_array[write] = element;
+            write = QueueNextIndex(queue, write);
+        }
+        read = QueueNextIndex(queue, read);
+    }
+    queue->rear = write;
+    for (uint32_t i = 0; i < queue->tombstones_count; ++i)
+    {
+        queue->elements_array[write] = NULL;
+        write = QueueNextIndex(queue, write);
+    }
+    queue->tombstones_count = 0;
+}
+
 void QueueInit(SimpleQueue* queue, const void** buffer, size_t size)
 {
-    queue->rear = queue->front = queue->elements_count = 0;
+    queue->rear = queue->front = queue->elements_count = queue->tombstones_count = 0;
     queue->elements_array = buffer;
     queue->size = size;
     memset(buffer, NULL, size * sizeof(void*));
 }
 
 ErrorCode Push(SimpleQueue* queue, const void* element)
+{
+    return PushGetSlot(queue, element, NULL);
+}
+
+ErrorCode PushGetSlot(SimpleQueue* queue, const void* element, uint32_t* slot)
 {
     RETURN_EC_ON_FAIL(!IsFull(queue), ADSP_SIMPLE_QUEUE_FULL);
+    if (queue->elements_count + queue->tombstones_count >= queue->size)
+    {
+#pragma frequency_hint NEVER
+        QueueCompact(queue);
+    }
+    if (slot != NULL)
+        *slot = queue->rear;
     queue->elements_array[queue->rear] = element;
     queue->rear = (queue->rear + 1) % queue->size;
     queue->elements_count += 1;
@@ -27,6 +88,7 @@ ErrorCode Push(SimpleQueue* queue, const void* element)
 ErrorCode Pop(SimpleQueue* queue, const void** element)
 {
     RETURN_EC_ON_FAIL(!IsFree(queue), ADSP_SIMPLE_QUEUE_EMPTY);
+    QueueDropFrontTombstones(queue);
     if (element != NULL)
         *element = queue->elements_array[queue->front];
     queue->elements_array[queue->front] = NULL;
@@ -40,7 +102,11 @@ ErrorCode Peek(const SimpleQueue* queue, const void** element)
 {
     RETURN_EC_ON_FAIL(element != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
     RETURN_EC_ON_FAIL(!IsFree(queue), ADSP_SIMPLE_QUEUE_EMPTY);
-    *element = queue->elements_array[queue->front];
+    // live element exists, so the scan stops before rear
+    uint32_t index = queue->front;
+    while (queue->elements_array[index] == QUEUE_TOMBSTONE)
+        index = QueueNextIndex(queue, index);
+    *element = queue->elements_array[index];
     return ADSP_SUCCESS;
 }
 
@@ -48,8 +114,13 @@ ErrorCode Remove(SimpleQueue* queue, const void* element)
 {
     RETURN_EC_ON_FAIL(element != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
     RETURN_EC_ON_FAIL(!IsFree(queue), ADSP_SIMPLE_QUEUE_EMPTY);
+    // shifting below works on slots, tombstones must not be among them
+    if (queue->tombstones_count != 0)
+        QueueCompact(queue);
     bool found_element_to_remove = false;
-    for(size_t index = queue->front; index < queue->front + queue->elements_count; ++index)
+    // last slot is only checked, the one behind it may be front of a full queue
+    const size_t last_index = queue->front + queue->elements_count - 1;
+    for(size_t index = queue->front; index < last_index; ++index)
     {
         const size_t this_element_index = index % queue->size;
         const size_t next_element_index = (index + 1) % queue->size;
@@ -61,8 +132,12 @@ ErrorCode Remove(SimpleQueue* queue, const void* element)
         // Reorder queue.
         queue->elements_array[this_element_index] = queue->elements_array[next_element_index];
     }
-    // Remove last element and move rear pointer.
-    queue->elements_array[queue->rear] = NULL;
+    if (!found_element_to_remove)
+    {
+        found_element_to_remove = queue->elements_array[last_index % queue->size] == element;
+    }
+    RETURN_EC_ON_FAIL(found_element_to_remove, ADSP_NOT_FOUND);
+    // Move rear pointer and remove last element.
     if (queue->rear == 0)
     {
 #pragma frequency_hint NEVER
@@ -72,6 +147,175 @@ ErrorCode Remove(SimpleQueue* queue, const void* element)
     {
         --queue->rear;
     }
+    queue->elements_array[queue->rear] = NULL;
+    --queue->elements_count;
+    return ADSP_SUCCESS;
+}
+
+/*!
+  \brief Turns occupied slot at index into tombstone, or releases it when it is the last one.
+*/
+static void QueueRemoveSlot(SimpleQueue* queue, uint32_t index)
+{
     --queue->elements_count;
+    if (QueueNextIndex(queue, index) == queue->rear)
+    {
+        // last element, move rear back over it and tombstones before it
+        queue->elements_array[index] = NULL;
+        queue->rear = index;
+        while (queue->tombstones_count != 0)
+        {
+            const uint32_t previous = (queue->rear == 0) ? queue->size - 1 : queue->rear - 1;
+            if (queue->elements_array[previous] != QUEUE_TOMBSTONE)
+                break;
+            queue->elements_array[previous] = NULL;
+            queue->rear = previous;
+            --queue->tombstones_count;
+        }
+    }
+    else
+    {
+        queue->elements_array[index] = QUEUE_TOMBSTONE;
+        ++queue->tombstones_count;
+        QueueDropFrontTombstones(queue);
+    }
+    if (queue->tombstones_count * 2 > queue->size)
+        QueueCompact(queue);
+}
+
+ErrorCode RemoveLazy(SimpleQueue* queue, const void* element)
+{
+    RETURN_EC_ON_FAIL(element != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
+    RETURN_EC_ON_FAIL(!IsFree(queue), ADSP_SIMPLE_QUEUE_EMPTY);
+    const uint32_t occupied = queue->elements_count + queue->tombstones_count;
+    uint32_t index = queue->front;
+    uint32_t i = 0;
+    for (; i < occupied && queue->elements_array[index] != element; ++i)
+        index = QueueNextIndex(queue, index);
+    RETURN_EC_ON_FAIL(i < occupied, ADSP_NOT_FOUND);
+    QueueRemoveSlot(queue, index);
+    return ADSP_SUCCESS;
+}
+
+ErrorCode RemoveLazyAt(SimpleQueue* queue, uint32_t slot, const void* element)
+{
+    RETURN_EC_ON_FAIL(element != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
+    RETURN_EC_ON_FAIL(slot < queue->size, ADSP_ERROR_INVALID_PARAM);
+    // released slots are cleared, so a stale slot holds NULL, a tombstone or another element
+    RETURN_EC_ON_FAIL(queue->elements_array[slot] == element, ADSP_NOT_FOUND);
+    QueueRemoveSlot(queue, slot);
+    return ADSP_SUCCESS;
+}
+
+/*!
+  \brief Copies count slots starting at index out of the ring, no tombstones expected.
+*/
+static void QueueCopyOut(const SimpleQueue* queue, uint32_t index, const void** elements, uint32_t count)
+{
+    const uint32_t head = min(count, (uint32_t)(queue->size - index));
+    memcpy_s(elements, count * sizeof(void*), &queue->elements_array[index], head * sizeof(void*));
+    memcpy_s(elements + head, (count - head) * sizeof(void*), queue->elements_array, (count - head) * sizeof(void*));
+}
+
+uint32_t PushN(SimpleQueue* queue, const void* const* elements, uint32_t count)
+{
+    count = min(count, (uint32_t)(queue->size - queue->elements_count));
+    if (count == 0)
+        return 0;
+    if (queue->elements_count + queue->tombstones_count + count > queue->size)
+        QueueCompact(queue);
+    const uint32_t rear = queue->rear;
+    const uint32_t head = min(count, (uint32_t)(queue->size - rear));
+    memcpy_s(&queue->elements_array[rear], (queue->size - rear) * sizeof(void*), elements, head * sizeof(void*));
+    memcpy_s(queue->elements_array, rear * sizeof(void*), elements + head, (count - head) * sizeof(void*));
+    queue->rear = (count - head != 0) ? count - head : rear + count;
+    if (queue->rear == queue->size)
+        queue->rear = 0;
+    queue->elements_count += count;
+    FLOG(L_INFO, "Queue::PushN count: %d rear: %d front: %d", queue->elements_count, queue->rear, queue->front);
+    return count;
+}
+
+uint32_t PopN(SimpleQueue* queue, const void** elements, uint32_t count)
+{
+    count = min(count, queue->elements_count);
+    if (count == 0)
+        return 0;
+    if (queue->tombstones_count != 0)
+        QueueCompact(queue);
+    const uint32_t front = queue->front;
+    const uint32_t head = min(count, (uint32_t)(queue->size - front));
+    QueueCopyOut(queue, front, elements, count);
+    memset(&queue->elements_array[front], 0, head * sizeof(void*));
+    memset(queue->elements_array, 0, (count - head) * sizeof(void*));
+    queue->front = (count - head != 0) ? count - head : front + count;
+    if (queue->front == queue->size)
+        queue->front = 0;
+    queue->elements_count -= count;
+    FLOG(L_INFO, "Queue::PopN count: %d rear: %d front: %d", queue->elements_count, queue->rear, queue->front);
+    return count;
+}
+
+uint32_t PeekN(const SimpleQueue* queue, const void** elements, uint32_t count)
+{
+    count = min(count, queue->elements_count);
+    if (queue->tombstones_count == 0)
+    {
+        if (count != 0)
+            QueueCopyOut(queue, queue->front, elements, count);
+        return count;
+    }
+    // queue cannot be compacted here, skip tombstones one by one
+    uint32_t index = queue->front;
+    for (uint32_t i = 0; i < count; index = QueueNextIndex(queue, index))
+    {
+        if (queue->elements_array[index] != QUEUE_TOMBSTONE)
+            elements[i++] = queue->elements_array[index];
+    }
+    return count;
+}
+
+ErrorCode SpscQueueInit(SpscQueue* queue, const void** buffer, size_t size)
+{
+    RETURN_EC_ON_FAIL(buffer != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
+    RETURN_EC_ON_FAIL(size != 0 && (size & (size - 1)) == 0, ADSP_ERROR_INVALID_PARAM);
+    queue->front = queue->rear = 0;
+    queue->mask = size - 1;
+    queue->elements_array = buffer;
+    memset(buffer, 0, size * sizeof(void*));
+    return ADSP_SUCCESS;
+}
+
+ErrorCode SpscPush(SpscQueue* queue, const void* element)
+{
+    const uint32_t rear = queue->rear;
+    RETURN_EC_ON_FAIL(rear - queue->front <= queue->mask, ADSP_SIMPLE_QUEUE_FULL);
+    queue->elements_array[rear & queue->mask] = element;
+    // element has to be in place before consumer can see it
+    SPSC_QUEUE_BARRIER();
+    queue->rear = rear + 1;
+    return ADSP_SUCCESS;
+}
+
+ErrorCode SpscPop(SpscQueue* queue, const void** element)
+{
+    const uint32_t front = queue->front;
+    RETURN_EC_ON_FAIL(queue->rear != front, ADSP_SIMPLE_QUEUE_EMPTY);
+    SPSC_QUEUE_BARRIER();
+    if (element != NULL)
+        *element = queue->elements_array[front & queue->mask];
+    // slot is read before producer can reuse it
+    SPSC_QUEUE_BARRIER();
+    queue->front = front + 1;
+    return ADSP_SUCCESS;
+}
+
+ErrorCode SpscPeek(const SpscQueue* queue, const void** element)
+{
+    RETURN_EC_ON_FAIL(element != NULL, ADSP_ERROR_NULL_POINTER_AS_PARAM);
+    const uint32_t front = queue->front;
+    RETURN_EC_ON_FAIL(queue->rear != front, ADSP_SIMPLE_QUEUE_EMPTY);
+    SPSC_QUEUE_BARRIER();
+    *element = queue->elements_array[front & queue->mask];
     return ADSP_SUCCESS;
 }
@@ -11,17 +11,21 @@
 #include "syntax_sugar.h"
 #include "adsp_assert.h"
 #include "adsp_error.h"
+#include "platform/memory_defs.h"
 
 /*!
   \brief SimpleQueue is a FIFO container.
   It encapsulates all logic required to push, peek and pop elements from fifo.
   Memory for elements is maintained out of the queue.
+  Elements removed by RemoveLazy() stay in their slots as tombstones until
+  Pop/Peek pass them or the queue is compacted, elements_count holds live elements only.
  */
 typedef struct _SimpleQueue
 {
     uint32_t rear;
     uint32_t front;
     uint32_t elements_count;
+    uint32_t tombstones_count;
     size_t size;
     const void** elements_array;
 } SimpleQueue;
@@ -74,6 +78,14 @@ ErrorCode Peek(const SimpleQueue* queue, const void** element);
   \return         error code
 */
 ErrorCode Push(SimpleQueue* queue, const void* element);
+/*!
+  \brief Push element to the queue and report the slot it was stored in.
+  \param  queue   Pointer to SimpleQueue structure
+  \param  element element to push
+  \param  slot    <out> slot index, handle for RemoveLazyAt(), can be NULL
+  \return         error code
+*/
+ErrorCode PushGetSlot(SimpleQueue* queue, const void* element, uint32_t* slot);
 /*!
   \brief Retrieve the oldest element.
   \param  queue   Pointer to SimpleQueue structure
@@ -82,12 +94,126 @@ ErrorCode Push(SimpleQueue* queue, const void* element);
 */
 ErrorCode Pop(SimpleQueue* queue, const void** element);
 /*!
-  \brief Remove element from the queue.
+  \brief Remove element from the queue, following elements are moved to close the gap.
   \param  queue   Pointer to SimpleQueue structure
   \param  element element to remove
-  \return         error code
+  \return         ADSP_NOT_FOUND when element is not queued
 */
 ErrorCode Remove(SimpleQueue* queue, const void* element);
+/*!
+  \brief Remove element from the queue without moving other elements.
+  Slot is marked as tombstone and skipped by Pop/Peek, queue is compacted once
+  tombstones take more than half of it, so FIFO order of remaining elements is kept.
+  \param  queue   Pointer to SimpleQueue structure
+  \param  element element to remove
+  \return         ADSP_NOT_FOUND when element is not queued
+*/
+ErrorCode RemoveLazy(SimpleQueue* queue, const void* element);
+/*!
+  \brief RemoveLazy() in O(1) for element whose slot was reported by PushGetSlot().
+  Slot is a valid handle until the element leaves the queue or the queue is
+  compacted (which moves elements); a stale slot is detected, as it no longer
+  holds element, and the caller may fall back to RemoveLazy().
+  \param  queue   Pointer to SimpleQueue structure
+  \param  slot    slot index reported by PushGetSlot()
+  \param  element element stored in the slot
+  \return         ADSP_NOT_FOUND when slot does not hold element
+*/
+ErrorCode RemoveLazyAt(SimpleQueue* queue, uint32_t slot, const void* element);
+/*!
+  \brief Push up to count elements, they are copied in at most two contiguous segments.
+  \param  queue    Pointer to SimpleQueue structure
+  \param  elements elements to push, oldest first
+  \param  count    number of elements
+  \return          number of elements pushed, less than count when queue gets full
+*/
+uint32_t PushN(SimpleQueue* queue, const void* const* elements, uint32_t count);
+/*!
+  \brief Retrieve up to count oldest elements.
+  \param  queue    Pointer to SimpleQueue structure
+  \param  elements <out> container for retrieved elements, oldest first
+  \param  count    capacity of elements
+  \return          number of elements popped
+*/
+uint32_t PopN(SimpleQueue* queue, const void** elements, uint32_t count);
+/*!
+  \brief Retrieve up to count oldest elements but don't remove them from queue.
+  \return number of elements retrieved
+*/
+uint32_t PeekN(const SimpleQueue* queue, const void** elements, uint32_t count);
+
+/*!
+  \brief SpscQueue is a lock-free FIFO of pointers for one producer and one consumer
+  running on the same core, e.g. an interrupt handler pushing and a thread popping.
+  Neither side masks interrupts.
+
+  Indices run freely and are masked on access, so no counter is shared:
+  rear is written by the producer only, front by the consumer only, each on
+  its own cache line. Capacity must be a power of two.
+  Memory for elements is maintained out of the queue.
+ */
+typedef struct _SpscQueue
+{
+    // written by consumer only
+    DCACHE_ALIGN volatile uint32_t front;
+    // written by producer only
+    DCACHE_ALIGN volatile uint32_t rear;
+    DCACHE_ALIGN uint32_t mask;
+    const void** elements_array;
+} SpscQueue;
+
+/*!
+  \brief Orders element accesses against index updates of SpscQueue.
+  Both sides run on one core, so preventing compiler reordering is sufficient.
+*/
+#define SPSC_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+/*!
+  \brief Initialize queue, must not race with SpscPush / SpscPop.
+  \param queue  SpscQueue structure to Initialize
+  \param buffer container for the queue elements
+  \param size   Number of elements, power of two
+  \return       ADSP_ERROR_INVALID_PARAM when size is not a power of two
+*/
+ErrorCode SpscQueueInit(SpscQueue* queue, const void** buffer, size_t size);
+/*!
+  \brief Get number of elements in the queue, exact only when called by producer or consumer.
+  \param  queue Pointer to SpscQueue structure
+  \return       number of elements
+*/
+ FORCE_INLINE inline uint32_t SpscGetElementsCount(const SpscQueue* queue)
+ {
+     return queue->rear - queue->front;
+ }
+ FORCE_INLINE inline uint32_t SpscIsFull(const SpscQueue* queue)
+ {
+     return SpscGetElementsCount(queue) > queue->mask;
+ }
+ FORCE_INLINE inline uint32_t SpscIsFree(const SpscQueue* queue)
+ {
+     return queue->rear == queue->front;
+ }
+/*!
+  \brief Push element to the queue, producer side.
+  \param  queue   Pointer to SpscQueue structure
+  \param  element element to push
+  \return         ADSP_SIMPLE_QUEUE_FULL when there is no space
+*/
+ErrorCode SpscPush(SpscQueue* queue, const void* element);
+/*!
+  \brief Retrieve the oldest element, consumer side.
+  \param  queue   Pointer to SpscQueue structure
+  \param  element <out> container for retrieved element. Can be NULL.
+  \return         ADSP_SIMPLE_QUEUE_EMPTY when there is nothing to pop
+*/
+ErrorCode SpscPop(SpscQueue* queue, const void** element);
+/*!
+  \brief Retrieve the oldest element but don't remove it from queue, consumer side.
+  \param  queue   Pointer to SpscQueue structure
+  \param  element <out> container for retrieved element
+  \return         error code
+*/
+ErrorCode SpscPeek(const SpscQueue* queue, const void** element);
 
 #ifdef __cplusplus
 
@@ -142,10 +268,11 @@ public:
 
     T sum() const
     {
+        // order does not matter, elements[0, elements_cnt) are exactly the queued ones
         T sum = T();
-        for (size_t index = 0; index < len(); index++)
+        for (size_t index = 0; index < elements_cnt; index++)
         {
-            sum += this->operator [](index);
+            sum += elements[index];
         }
         return sum;
     }
@@ -171,6 +298,239 @@ private:
     uint32_t position;
 };
 
+/*!
+  \brief Tells StatsWindow whether its accumulator rounds (floating point) or is exact.
+*/
+template<class ACC>
+struct StatsAccumulator
+{
+    enum { FLOATING = 0 };
+};
+template<>
+struct StatsAccumulator<float>
+{
+    enum { FLOATING = 1 };
+};
+template<>
+struct StatsAccumulator<double>
+{
+    enum { FLOATING = 1 };
+};
+
+/*!
+  \brief Sliding window over the last N appended values with constant time statistics.
+
+  Sum and sum of squares are updated on every append, minimum and maximum are kept
+  in monotonic deques (values which can never become the extreme are dropped),
+  so append is O(1) amortized and every query is O(1).
+  ACC is the accumulator type of sum, mean and variance and has to be wider than T
+  or floating point. An integer ACC is exact as long as N * max(T)^2 fits in it,
+  e.g. uint64_t holds 16-bit values for any N but 32-bit values only below
+  2^32 / sqrt(N); use double beyond that. A floating point ACC accumulates values
+  relative to the window mean and is rebuilt from the elements every N appends,
+  so rounding neither drifts nor cancels out the variance of values far from zero.
+
+  \code
+      StatsWindow<uint32_t, 16, uint64_t> load;
+      load.append(cycles);
+      report(load.mean(), load.min_value(), load.max_value());
+  \endcode
+*/
+template<class T, size_t N, class ACC>
+class StatsWindow
+{
+    static_assert(sizeof(ACC) > sizeof(T) || StatsAccumulator<ACC>::FLOATING,
+                  "accumulator has to be wider than the element or floating point");
+
+public:
+    StatsWindow()
+    {
+        clear();
+    }
+
+    /*!
+      \brief Appends element, returns the element which left the window (T() if none).
+    */
+    T append(T element)
+    {
+        T popping_out = T();
+        if (elements_cnt == 0 && StatsAccumulator<ACC>::FLOATING)
+            shift_ = static_cast<ACC>(element);
+        const ACC value = static_cast<ACC>(element) - shift_;
+        if (elements_cnt == N)
+        {
+            popping_out = elements[position];
+            const ACC old = static_cast<ACC>(popping_out) - shift_;
+            sum_ -= old;
+            sum_squares_ -= old * old;
+        }
+        elements[position] = element;
+        elements_cnt = min(elements_cnt + 1, N);
+        position = (position + 1) % N;
+        sum_ += value;
+        sum_squares_ += value * value;
+        if (position == 0 && StatsAccumulator<ACC>::FLOATING)
+            rebuild_sums();
+
+        // entries older than the window leave at the front, dominated ones at the back
+        if (min_.cnt != 0 && sequence - min_.front_sequence() >= N)
+            min_.pop_front();
+        if (max_.cnt != 0 && sequence - max_.front_sequence() >= N)
+            max_.pop_front();
+        while (min_.cnt != 0 && !(min_.back() < element))
+            min_.pop_back();
+        while (max_.cnt != 0 && !(element < max_.back()))
+            max_.pop_back();
+        min_.push_back(element, sequence);
+        max_.push_back(element, sequence);
+        sequence++;
+        return popping_out;
+    }
+
+    size_t len() const
+    {
+        return elements_cnt;
+    }
+    size_t size() const
+    {
+        return N;
+    }
+
+    void clear()
+    {
+        position = 0;
+        elements_cnt = 0;
+        sequence = 0;
+        shift_ = ACC();
+        sum_ = ACC();
+        sum_squares_ = ACC();
+        min_.clear();
+        max_.clear();
+    }
+
+    ACC sum() const
+    {
+        return sum_ + shift_ * static_cast<ACC>(elements_cnt);
+    }
+
+    /*!
+      \brief Returns mean of the window, ACC() when empty.
+    */
+    ACC mean() const
+    {
+        return elements_cnt ? shift_ + sum_ / static_cast<ACC>(elements_cnt) : ACC();
+    }
+
+    /*!
+      \brief Returns population variance of the window, ACC() when empty.
+    */
+    ACC variance() const
+    {
+        if (elements_cnt == 0)
+            return ACC();
+        const ACC count = static_cast<ACC>(elements_cnt);
+        const ACC mean_squares = sum_squares_ / count;
+        const ACC mean_value = sum_ / count;
+        // clamp rounding noise of unsigned or floating point accumulators
+        return mean_squares > mean_value * mean_value ? mean_squares - mean_value * mean_value : ACC();
+    }
+
+    /*!
+      \brief Returns minimum of the window, must not be called when empty.
+    */
+    T min_value() const
+    {
+        assert(min_.cnt != 0);
+        return min_.front();
+    }
+
+    /*!
+      \brief Returns maximum of the window, must not be called when empty.
+    */
+    T max_value() const
+    {
+        assert(max_.cnt != 0);
+        return max_.front();
+    }
+
+private:
+    /*!
+      \brief Recomputes the sums of a full window around its current mean.
+    */
+    void rebuild_sums()
+    {
+        ACC total = ACC();
+        for (size_t i = 0; i < N; ++i)
+            total += static_cast<ACC>(elements[i]);
+        shift_ = total / static_cast<ACC>(N);
+        sum_ = ACC();
+        sum_squares_ = ACC();
+        for (size_t i = 0; i < N; ++i)
+        {
+            const ACC value = static_cast<ACC>(elements[i]) - shift_;
+            sum_ += value;
+            sum_squares_ += value * value;
+        }
+    }
+
+    /*!
+      \brief Ring of (value, sequence) pairs, at most N entries.
+    */
+    struct MonotonicDeque
+    {
+        void clear()
+        {
+            head = 0;
+            cnt = 0;
+        }
+        T front() const
+        {
+            return values[head];
+        }
+        uint32_t front_sequence() const
+        {
+            return sequences[head];
+        }
+        T back() const
+        {
+            return values[(head + cnt - 1) % N];
+        }
+        void pop_front()
+        {
+            head = (head + 1) % N;
+            cnt--;
+        }
+        void pop_back()
+        {
+            cnt--;
+        }
+        void push_back(T value, uint32_t seq)
+        {
+            const size_t tail = (head + cnt) % N;
+            values[tail] = value;
+            sequences[tail] = seq;
+            cnt++;
+        }
+
+        T values[N];
+        uint32_t sequences[N];
+        size_t head;
+        size_t cnt;
+    };
+
+    T elements[N];
+    size_t elements_cnt;
+    uint32_t position;
+    // number of appended elements, wraps harmlessly (only differences are used)
+    uint32_t sequence;
+    // floating point sums are kept relative to it, zero for integer ACC
+    ACC shift_;
+    ACC sum_;
+    ACC sum_squares_;
+    MonotonicDeque min_;
+    MonotonicDeque max_;
+};
+
 }  // namespace dsp_fw
 
 #endif  // __cplusplus
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#include "adsp_std_defs.h"
+#include "timing_wheel.h"
+
+namespace dsp_fw
+{
+
+static FORCE_INLINE void wheel_unlink(WheelTimer* timer)
+{
+    *timer->pprev = timer->next;
+    if (timer->next != NULL)
+        timer->next->pprev = timer->pprev;
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+static FORCE_INLINE void wheel_link(WheelTimer** head, WheelTimer* timer)
+{
+    timer->next = *head;
+    if (*head != NULL)
+        (*head)->pprev = &timer->next;
+    timer->pprev = head;
+    *head = timer;
+}
+
+TimingWheel::TimingWheel() : now_(0)
+{
+    ClearSlots();
+}
+
+#ifdef UT
+TimingWheel::TimingWheel(uint32_t start_ticks) : now_(start_ticks)
+{
+    ClearSlots();
+}
+#endif
+
+void TimingWheel::ClearSlots()
+{
+    for (uint32_t level = 0; level < LEVELS; ++level)
+    {
+        for (uint32_t slot = 0; slot < SLOTS; ++slot)
+            slots_[level][slot] = NULL;
+    }
+}
+
+void TimingWheel::Place(WheelTimer* timer)
+{
+    const uint32_t now = now_;
+    uint32_t delta = timer->expires - now;
+    // far timers wait in the last level slot reached after MAX_DELAY
+    delta = min(delta, MAX_DELAY);
+    const uint32_t target = now + delta;
+    uint32_t level = 0;
+    while (level < LEVELS - 1 && delta >= (1U << (SLOT_BITS * (level + 1))))
+        ++level;
+    const uint32_t slot = (target >> (SLOT_BITS * level)) & (SLOTS - 1);
+    wheel_link(&slots_[level][slot], timer);
+}
+
+void TimingWheel::Cascade(uint32_t level)
+{
+    WheelTimer** head = &slots_[level][(now_ >> (SLOT_BITS * level)) & (SLOTS - 1)];
+    WheelTimer* timer = *head;
+    *head = NULL;
+    while (timer != NULL)
+    {
+        WheelTimer* next = timer->next;
+        Place(timer);
+        timer = next;
+    }
+}
+
+ErrorCode TimingWheel::Start(WheelTimer* timer, uint32_t delay_ticks, WheelTimerCallback callback, void* context)
+{
+    RETURN_EC_ON_FAIL(timer != NULL && callback != NULL, ADSP_ERROR_INVALID_PARAM);
+    ENTER_CRITICAL_SECTION(0);
+    if (timer->pprev != NULL)
+        wheel_unlink(timer);
+    timer->callback = callback;
+    timer->context = context;
+    // slot of the current tick was already processed
+    timer->expires = now_ + max(delay_ticks, 1U);
+    Place(timer);
+    LEAVE_CRITICAL_SECTION(0);
+    return ADSP_SUCCESS;
+}
+
+void TimingWheel::Cancel(WheelTimer* timer)
+{
+    ENTER_CRITICAL_SECTION(0);
+    if (timer->pprev != NULL)
+        wheel_unlink(timer);
+    LEAVE_CRITICAL_SECTION(0);
+}
+
+void TimingWheel::Tick()
+{
+    ENTER_CRITICAL_SECTION(0);
+    const uint32_t now = now_ + 1;
+    now_ = now;
+    // when a level wraps, the next slot of the level above moves one level down,
+    // coarsest first so its timers can continue down in the same tick
+    uint32_t levels = 1;
+    while (levels < LEVELS && (now & ((1U << (SLOT_BITS * levels)) - 1)) == 0)
+        ++levels;
+    for (uint32_t level = levels - 1; level > 0; --level)
+        Cascade(level);
+    WheelTimer** head = &slots_[0][now & (SLOTS - 1)];
+    while (*head != NULL)
+    {
+        WheelTimer* timer = *head;
+        wheel_unlink(timer);
+        if (timer->expires != now)
+        {
+#pragma frequency_hint NEVER
+            // parked beyond MAX_DELAY, not due yet
+            Place(timer);
+            continue;
+        }
+        // callback may restart this timer or touch other ones
+        timer->callback(timer->context);
+    }
+    LEAVE_CRITICAL_SECTION(0);
+}
+
+void TimingWheel::SignalFlag(void* context)
+{
+    *(volatile uint32_t*)context = 1;
+}
+
+}
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef ADSP_FW_UTILITIES_TIMING_WHEEL_H
+#define ADSP_FW_UTILITIES_TIMING_WHEEL_H
+
+#include "adsp_std_defs.h"
+#include "adsp_error.h"
+
+namespace dsp_fw
+{
+
+typedef void (*WheelTimerCallback)(void* context);
+
+/*!
+  \brief Timer entry linked into TimingWheel, memory is owned by the caller
+  and must stay valid while the timer is pending.
+*/
+struct WheelTimer
+{
+    WheelTimer() : next(NULL), pprev(NULL), expires(0), callback(NULL), context(NULL) {}
+
+    WheelTimer* next;
+    // address of the pointer referring to this entry, NULL when not pending
+    WheelTimer** pprev;
+    uint32_t expires;
+    WheelTimerCallback callback;
+    void* context;
+};
+
+/*!
+  \brief Hierarchical timing wheel, one instance per core driven by a single
+  periodic tick instead of every timeout polling the wall clock on its own.
+
+  LEVELS wheels of SLOTS slots, level n slot covers SLOTS^n ticks, so delays up
+  to MAX_DELAY ticks are kept without sorting. Start() and Cancel() are O(1),
+  a timer is moved to a finer level at most LEVELS - 1 times before it fires.
+  Longer delays are parked on the last level and re-placed when reached.
+
+  Callbacks are called from Tick(), i.e. in timer interrupt context; they have
+  to be short and may restart or cancel timers. Threads wait for a timeout by
+  blocking on a flag set by SignalFlag():
+  \code
+      volatile uint32_t timed_out = 0;
+      WheelTimer timer;
+      wheel->Start(&timer, delay_ticks, TimingWheel::SignalFlag, (void*)&timed_out);
+      BlockCurrentThreadedTask blockade(&timed_out, 1);
+  \endcode
+*/
+class TimingWheel
+{
+public:
+    static const uint32_t SLOT_BITS = 6;
+    static const uint32_t SLOTS = 1U << SLOT_BITS;
+    static const uint32_t LEVELS = 4;
+    static const uint32_t MAX_DELAY = (1U << (SLOT_BITS * LEVELS)) - 1;
+
+    TimingWheel();
+#ifdef UT
+    /*!
+      \brief Starts the tick counter at start_ticks, lets host tests reach its wrap.
+    */
+    explicit TimingWheel(uint32_t start_ticks);
+#endif
+
+    /*!
+      \brief Arms timer to expire after delay_ticks (at least one) ticks,
+      pending timer is re-armed.
+      \return ADSP_ERROR_INVALID_PARAM when timer or callback is NULL
+    */
+    ErrorCode Start(WheelTimer* timer, uint32_t delay_ticks, WheelTimerCallback callback, void* context);
+
+    /*!
+      \brief Disarms timer, no effect when it is not pending.
+    */
+    void Cancel(WheelTimer* timer);
+
+    bool IsPending(const WheelTimer* timer) const
+    {
+        return timer->pprev != NULL;
+    }
+
+    /*!
+      \brief Advances wheel by one tick and calls callbacks of expired timers.
+      To be called from the periodic timer interrupt of the owning core.
+    */
+    void Tick();
+
+    uint32_t GetTicks() const
+    {
+        return now_;
+    }
+
+    /*!
+      \brief Callback which sets *(volatile uint32_t*)context to 1.
+    */
+    static void SignalFlag(void* context);
+
+private:
+    void ClearSlots();
+    void Place(WheelTimer* timer);
+    void Cascade(uint32_t level);
+
+    // heads of singly linked slot lists, entries keep back links to allow O(1) unlink
+    WheelTimer* slots_[LEVELS][SLOTS];
+    volatile uint32_t now_;
+};
+
+}
+
+#endif // ADSP_FW_UTILITIES_TIMING_WHEEL_H
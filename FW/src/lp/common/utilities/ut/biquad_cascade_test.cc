@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of biquad_cascade.h against a per channel transposed direct form II
+  computed in double (float cascade) and a scalar model of the Q1.31 arithmetic
+  (int32_t cascade, bit-exact). Covers coefficient validation, the double buffered
+  update and prints cost per frame of every configuration. Build with -mavx2 to
+  measure the vectorized int32_t stages.
+
+  g++ -DUT -O3 -I<stubs> -I.. biquad_cascade_test.cc -lm
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include "biquad_cascade.h"
+#include "ut_bench.h"
+#include "ut_check.h"
+
+using namespace dsp_fw;
+
+static const uint32_t STAGES = 6;
+static const uint32_t FRAMES = 480;
+static const double Q31_ONE = 2147483648.0;
+
+static double random_unit()
+{
+    return (double)rand() / RAND_MAX * 2.0 - 1.0;
+}
+
+/*!
+  \brief Stable stage with poles at radius r < 0.95 and |b| < 1, within Q2.30.
+*/
+static BiquadCoefs random_coefs()
+{
+    const double radius = 0.5 + 0.45 * fabs(random_unit());
+    const double angle = M_PI * fabs(random_unit());
+    BiquadCoefs c;
+    c.b0 = (float)(0.5 + 0.4 * random_unit());
+    c.b1 = (float)(0.9 * random_unit());
+    c.b2 = (float)(0.5 * random_unit());
+    c.a1 = (float)(-2.0 * radius * cos(angle));
+    c.a2 = (float)(radius * radius);
+    return c;
+}
+
+struct ReferenceState
+{
+    double s1, s2;
+};
+
+static double reference_stage(const BiquadCoefs& c, ReferenceState& s, double in)
+{
+    const double y = c.b0 * in + s.s1;
+    s.s1 = c.b1 * in - c.a1 * y + s.s2;
+    s.s2 = c.b2 * in - c.a2 * y;
+    return y;
+}
+
+template <uint32_t LANES>
+static void test_float(uint32_t channels)
+{
+    static BiquadCoefs coefs[STAGES * LANES];
+    static float in[FRAMES * LANES], out[FRAMES * LANES];
+    for (uint32_t idx = 0; idx < STAGES * channels; ++idx)
+        coefs[idx] = random_coefs();
+    for (uint32_t idx = 0; idx < FRAMES * channels; ++idx)
+        in[idx] = (float)(0.5 * random_unit());
+
+    BiquadCascade<float, LANES, STAGES> cascade;
+    UT_CHECK(cascade.Init(STAGES, channels, coefs) == ADSP_SUCCESS);
+    // two blocks, so state has to carry over
+    cascade.Process(in, out, FRAMES / 2);
+    cascade.Process(in + FRAMES / 2 * channels, out + FRAMES / 2 * channels, FRAMES / 2);
+
+    ReferenceState state[STAGES * LANES] = {};
+    double error = 0;
+    for (uint32_t frame = 0; frame < FRAMES; ++frame)
+    {
+        for (uint32_t ch = 0; ch < channels; ++ch)
+        {
+            double x = in[frame * channels + ch];
+            for (uint32_t stage = 0; stage < STAGES; ++stage)
+                x = reference_stage(coefs[stage * channels + ch], state[stage * channels + ch], x);
+            error = fmax(error, fabs(out[frame * channels + ch] - x));
+        }
+    }
+    UT_CHECK(error < 1e-4);
+}
+
+/*!
+  \brief Scalar model of the Q1.31 stage, products of Q2.30 coefficients shifted by 30.
+*/
+static int32_t model_sat(int64_t value)
+{
+    return value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : (int32_t)value);
+}
+
+static int32_t model_coef(float value)
+{
+    return (int32_t)lround((double)value * 1073741824.0);
+}
+
+template <uint32_t LANES>
+static void test_q31(uint32_t channels)
+{
+    static BiquadCoefs coefs[STAGES * LANES];
+    static int32_t in[FRAMES * LANES], out[FRAMES * LANES];
+    for (uint32_t idx = 0; idx < STAGES * channels; ++idx)
+        coefs[idx] = random_coefs();
+    for (uint32_t idx = 0; idx < FRAMES * channels; ++idx)
+        in[idx] = (int32_t)(random_unit() * (idx < FRAMES * channels / 2 ? 1e-3 : 1.0) * INT32_MAX);
+
+    BiquadCascade<int32_t, LANES, STAGES> cascade;
+    UT_CHECK(cascade.Init(STAGES, channels, coefs) == ADSP_SUCCESS);
+    // in place, first half is quiet enough for resonant stages, second half saturates
+    for (uint32_t idx = 0; idx < FRAMES * channels; ++idx)
+        out[idx] = in[idx];
+    cascade.Process(out, out, FRAMES);
+
+    int32_t s1[STAGES * LANES] = {}, s2[STAGES * LANES] = {};
+    uint32_t mismatches = 0;
+    double error = 0, peak = 0;
+    ReferenceState state[STAGES * LANES] = {};
+    for (uint32_t frame = 0; frame < FRAMES / 2; ++frame)
+    {
+        for (uint32_t ch = 0; ch < channels; ++ch)
+        {
+            int64_t x = in[frame * channels + ch];
+            double exact = x / Q31_ONE;
+            for (uint32_t stage = 0; stage < STAGES; ++stage)
+            {
+                const BiquadCoefs& c = coefs[stage * channels + ch];
+                const uint32_t idx = stage * channels + ch;
+                const int32_t y = model_sat(((model_coef(c.b0) * x) >> 30) + s1[idx]);
+                s1[idx] = model_sat(((model_coef(c.b1) * x - model_coef(c.a1) * (int64_t)y) >> 30) + s2[idx]);
+                s2[idx] = model_sat((model_coef(c.b2) * x - model_coef(c.a2) * (int64_t)y) >> 30);
+                x = y;
+                exact = reference_stage(c, state[idx], exact);
+                peak = fmax(peak, fabs(exact));
+            }
+            mismatches += out[frame * channels + ch] != x;
+            error = fmax(error, fabs(out[frame * channels + ch] / Q31_ONE - exact));
+        }
+    }
+    UT_CHECK(mismatches == 0);
+    // quantized coefficients and truncated products against double, while no stage saturates
+    printf("q31 %u channels max error %.3g at peak %.3g\n", channels, error, peak);
+    UT_CHECK(peak < 1.0);
+    UT_CHECK(error < 1e-6);
+
+    // saturated half has to match the model as well
+    for (uint32_t frame = FRAMES / 2; frame < FRAMES; ++frame)
+    {
+        for (uint32_t ch = 0; ch < channels; ++ch)
+        {
+            int64_t x = in[frame * channels + ch];
+            for (uint32_t stage = 0; stage < STAGES; ++stage)
+            {
+                const BiquadCoefs& c = coefs[stage * channels + ch];
+                const uint32_t idx = stage * channels + ch;
+                const int32_t y = model_sat(((model_coef(c.b0) * x) >> 30) + s1[idx]);
+                s1[idx] = model_sat(((model_coef(c.b1) * x - model_coef(c.a1) * (int64_t)y) >> 30) + s2[idx]);
+                s2[idx] = model_sat((model_coef(c.b2) * x - model_coef(c.a2) * (int64_t)y) >> 30);
+                x = y;
+            }
+            mismatches += out[frame * channels + ch] != x;
+        }
+    }
+    UT_CHECK(mismatches == 0);
+}
+
+static void test_validation()
+{
+    BiquadCoefs coefs[2] = { { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } };
+    BiquadCascade<int32_t, 2, 2> fixed;
+    BiquadCascade<float, 2, 2> real;
+
+    UT_CHECK(fixed.Init(0, 1, coefs) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(fixed.Init(3, 1, coefs) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(fixed.Init(1, 3, coefs) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(fixed.Init(1, 1, NULL) == ADSP_ERROR_INVALID_PARAM);
+
+    // Q2.30 range is [-2, 2), coefficients beyond are not clipped
+    coefs[1].b0 = 2.5f;
+    UT_CHECK(fixed.Init(2, 1, coefs) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(real.Init(2, 1, coefs) == ADSP_SUCCESS);
+    coefs[1].b0 = 2.0f;
+    UT_CHECK(fixed.Init(2, 1, coefs) == ADSP_ERROR_INVALID_PARAM);
+    coefs[1].b0 = -2.0f;
+    UT_CHECK(fixed.Init(2, 1, coefs) == ADSP_SUCCESS);
+    coefs[1].b0 = 1.9999999f;
+    UT_CHECK(fixed.Init(2, 1, coefs) == ADSP_SUCCESS);
+    coefs[1].b0 = NAN;
+    UT_CHECK(fixed.Init(2, 1, coefs) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(real.Init(2, 1, coefs) == ADSP_ERROR_INVALID_PARAM);
+
+    // rejected update keeps coefficients in use, unity gain passes input through
+    coefs[1].b0 = 1.0f;
+    UT_CHECK(fixed.Init(2, 1, coefs) == ADSP_SUCCESS);
+    coefs[0].a1 = -3.0f;
+    UT_CHECK(fixed.SetCoefs(coefs) == ADSP_ERROR_INVALID_PARAM);
+    int32_t sample = 0x12345678;
+    fixed.Process(&sample, &sample, 1);
+    UT_CHECK(sample == 0x12345678);
+}
+
+static void test_update()
+{
+    BiquadCoefs unity[2] = { { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f } };
+    BiquadCoefs half[2] = { { 0.5f, 0.0f, 0.0f, 0.0f, 0.0f }, { 0.25f, 0.0f, 0.0f, 0.0f, 0.0f } };
+    BiquadCascade<float, 2, 1> cascade;
+    UT_CHECK(cascade.Init(1, 2, unity) == ADSP_SUCCESS);
+    UT_CHECK(cascade.GetStages() == 1);
+    UT_CHECK(cascade.GetChannels() == 2);
+
+    float frame[2] = { 1.0f, 1.0f };
+    UT_CHECK(cascade.SetCoefs(half) == ADSP_SUCCESS);
+    // not picked up by Process() yet
+    UT_CHECK(cascade.SetCoefs(unity) == ADSP_BUSY);
+    cascade.Process(frame, frame, 1);
+    UT_CHECK(frame[0] == 0.5f && frame[1] == 0.25f);
+    UT_CHECK(cascade.SetCoefs(unity) == ADSP_SUCCESS);
+    cascade.Process(frame, frame, 1);
+    UT_CHECK(frame[0] == 0.5f && frame[1] == 0.25f);
+
+    // state carries over the update: one sample delay line keeps the old sample
+    BiquadCoefs delay[1] = { { 0.0f, 1.0f, 0.0f, 0.0f, 0.0f } };
+    BiquadCascade<float, 2, 1> mono;
+    UT_CHECK(mono.Init(1, 1, delay) == ADSP_SUCCESS);
+    float sample = 0.75f;
+    mono.Process(&sample, &sample, 1);
+    UT_CHECK(sample == 0.0f);
+    UT_CHECK(mono.SetCoefs(delay) == ADSP_SUCCESS);
+    sample = 0.0f;
+    mono.Process(&sample, &sample, 1);
+    UT_CHECK(sample == 0.75f);
+}
+
+static float bench_float[FRAMES * 8];
+static int32_t bench_q31[FRAMES * 8];
+
+template <typename T, uint32_t LANES>
+struct CascadeCall
+{
+    BiquadCascade<T, LANES, STAGES>* cascade;
+    T* buffer;
+    void operator()()
+    {
+        cascade->Process(buffer, buffer, FRAMES);
+    }
+};
+
+template <typename T, uint32_t LANES>
+static void bench(const char* name, T* buffer)
+{
+    static BiquadCoefs coefs[STAGES * LANES];
+    for (uint32_t idx = 0; idx < STAGES * LANES; ++idx)
+        coefs[idx] = random_coefs();
+    static BiquadCascade<T, LANES, STAGES> cascade;
+    cascade.Init(STAGES, LANES, coefs);
+    CascadeCall<T, LANES> call = { &cascade, buffer };
+    const double ticks = ut_bench(call, FRAMES);
+    printf("%-6s %u channels %u stages %7.2f %s per frame, %5.2f per channel stage\n", name, LANES,
+           STAGES, ticks, UT_BENCH_UNIT, ticks / (LANES * STAGES));
+}
+
+static void test_cost()
+{
+    for (uint32_t idx = 0; idx < FRAMES * 8; ++idx)
+    {
+        bench_float[idx] = (float)(0.1 * random_unit());
+        bench_q31[idx] = (int32_t)(0.1 * random_unit() * INT32_MAX);
+    }
+    bench<float, 2>("float", bench_float);
+    bench<float, 4>("float", bench_float);
+    bench<float, 8>("float", bench_float);
+    bench<int32_t, 2>("q31", bench_q31);
+    bench<int32_t, 4>("q31", bench_q31);
+    bench<int32_t, 8>("q31", bench_q31);
+}
+
+int main()
+{
+    srand(1);
+    test_float<2>(2);
+    test_float<4>(3);
+    test_float<8>(8);
+    test_q31<2>(1);
+    test_q31<4>(4);
+    test_q31<8>(5);
+    test_validation();
+    test_update();
+    test_cost();
+    return ut_result();
+}
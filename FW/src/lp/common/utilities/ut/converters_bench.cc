@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Benchmark of the PCM converters, sweeping block size, misalignment and odd sample
+  counts for every kernel of the backend the program is built for. On Xtensa the HiFi
+  kernels of converters.cc and the metering variants are measured in cycles, on host
+  the portable C kernels of converters_codec.cc in ns. A memcpy of the same number of
+  16/32-bit samples is measured as the native PCM reference.
+
+  Output lines are "backend kernel block alignment ticks_per_sample" in the format of
+  converters_bench_<backend>.txt. When that file is given as argument, every
+  configuration is compared with it and exit code is non-zero when any is more than
+  BASELINE_TOLERANCE slower. Baselines are specific to the machine and compiler noted
+  in their header, regenerate with:  ./converters_bench > converters_bench_host.txt
+  Cycle counts from the ISS are exact, host numbers on a shared machine can swing
+  by 2x between runs, so host comparisons are only meaningful on an idle machine.
+
+  host:   g++ -DUT -O2 -I<stubs> -I.. converters_bench.cc ../converters_codec.cc
+  Xtensa: xt-clang++ -DUT -O2 -I<fw includes> -I.. converters_bench.cc ../converters.cc ../converters_codec.cc
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "converters.h"
+#include "ut_bench.h"
+
+#if defined(__XTENSA__)
+#include <xt_hifi_defs.h>
+static const char* const BACKEND = "hifi";
+#else
+static const char* const BACKEND = "host";
+#endif
+
+static const double BASELINE_TOLERANCE = 1.5;
+static const size_t BLOCK_SIZES[] = { 16, 48, 192, 960, 4096 };
+static const size_t MAX_BLOCK = 4096 + 1;
+#if defined(__XTENSA__)
+static const uint32_t METER_CHANNELS = 2;
+#endif
+
+struct BenchKernel
+{
+    const char* name;
+    void (*convert)(void* out, const void* in, size_t n_samples);
+    // smallest offset of the pointer the kernel accepts, used for the misaligned runs
+    size_t in_align;
+    size_t out_align;
+};
+
+#if defined(__XTENSA__)
+static ConverterMeter meter;
+#endif
+
+static void native_16b(void* out, const void* in, size_t n) { memcpy(out, in, n * 2); }
+static void native_32b(void* out, const void* in, size_t n) { memcpy(out, in, n * 4); }
+static void alaw_to_16b(void* out, const void* in, size_t n) { copy_alaw_to_16b((int16_t*)out, (const uint8_t*)in, n); }
+static void mulaw_to_16b(void* out, const void* in, size_t n) { copy_mulaw_to_16b((int16_t*)out, (const uint8_t*)in, n); }
+static void to_alaw(void* out, const void* in, size_t n) { copy_16b_to_alaw((uint8_t*)out, (const int16_t*)in, n); }
+static void to_mulaw(void* out, const void* in, size_t n) { copy_16b_to_mulaw((uint8_t*)out, (const int16_t*)in, n); }
+static void bswap_16b(void* out, const void* in, size_t n) { copy_16b_bswap((int16_t*)out, (const int16_t*)in, n); }
+static void bswap_32b(void* out, const void* in, size_t n) { copy_32b_bswap((int32_t*)out, (const int32_t*)in, n); }
+static void be24_to_32b(void* out, const void* in, size_t n) { copy_24b_be_to_32b((int8_t*)out, (const int8_t*)in, n); }
+static void to_be24(void* out, const void* in, size_t n) { copy_32b_to_24b_be((int8_t*)out, (const int8_t*)in, n); }
+#if defined(__XTENSA__)
+static void cb32_to_24b(void* out, const void* in, size_t n) { copy_32b_cb_to_24b((int8_t*)out, (const int8_t*)in, n); }
+static void d24_to_32b(void* out, const void* in, size_t n) { copy_24b_to_32b((int8_t*)out, (const int8_t*)in, n); }
+static void d32_to_24b(void* out, const void* in, size_t n) { copy_32b_to_24b((int8_t*)out, (const int8_t*)in, n); }
+static void d24_to_16b(void* out, const void* in, size_t n) { copy_24b_to_16b((int8_t*)out, (const int8_t*)in, n); }
+static void cb16_to_16b(void* out, const void* in, size_t n) { copy_16b_cb_to_16b((int16_t*)out, (const int16_t*)in, n); }
+static void d32_to_16b(void* out, const void* in, size_t n) { copy_32b_to_16b((int16_t*)out, (const int32_t*)in, n); }
+static void d24_to_32b_meter(void* out, const void* in, size_t n) { copy_24b_to_32b_meter((int8_t*)out, (const int8_t*)in, n, &meter); }
+static void d32_to_24b_meter(void* out, const void* in, size_t n) { copy_32b_to_24b_meter((int8_t*)out, (const int8_t*)in, n, &meter); }
+static void d24_to_16b_meter(void* out, const void* in, size_t n) { copy_24b_to_16b_meter((int8_t*)out, (const int8_t*)in, n, &meter); }
+static void d32_to_16b_meter(void* out, const void* in, size_t n) { copy_32b_to_16b_meter((int16_t*)out, (const int32_t*)in, n, &meter); }
+#endif
+
+static const BenchKernel KERNELS[] = {
+    { "native_16b", native_16b, 2, 2 },
+    { "native_32b", native_32b, 4, 4 },
+    { "alaw_to_16b", alaw_to_16b, 1, 2 },
+    { "mulaw_to_16b", mulaw_to_16b, 1, 2 },
+    { "16b_to_alaw", to_alaw, 2, 1 },
+    { "16b_to_mulaw", to_mulaw, 2, 1 },
+    { "16b_bswap", bswap_16b, 2, 2 },
+    { "32b_bswap", bswap_32b, 4, 4 },
+    { "24b_be_to_32b", be24_to_32b, 1, 4 },
+    { "32b_to_24b_be", to_be24, 4, 1 },
+#if defined(__XTENSA__)
+    // circular addressing kernels read through the ring set up in main()
+    { "32b_cb_to_24b", cb32_to_24b, 4, 1 },
+    { "24b_to_32b", d24_to_32b, 1, 4 },
+    { "32b_to_24b", d32_to_24b, 4, 1 },
+    { "24b_to_16b", d24_to_16b, 1, 2 },
+    { "16b_cb_to_16b", cb16_to_16b, 2, 2 },
+    { "32b_to_16b", d32_to_16b, 4, 2 },
+    { "24b_to_32b_meter", d24_to_32b_meter, 1, 4 },
+    { "32b_to_24b_meter", d32_to_24b_meter, 4, 1 },
+    { "24b_to_16b_meter", d24_to_16b_meter, 1, 2 },
+    { "32b_to_16b_meter", d32_to_16b_meter, 4, 2 },
+#endif
+};
+
+// largest container is 4 bytes, plus room for the misaligned start
+DCACHE_ALIGN static int8_t in_buffer[MAX_BLOCK * 4 + 8];
+DCACHE_ALIGN static int8_t out_buffer[MAX_BLOCK * 4 + 8];
+
+struct KernelCall
+{
+    const BenchKernel* kernel;
+    int8_t* out;
+    const int8_t* in;
+    size_t n_samples;
+
+    void operator()()
+    {
+        kernel->convert(out, in, n_samples);
+    }
+};
+
+static const char* const ALIGNMENTS[] = { "aligned", "in_misaligned", "out_misaligned" };
+
+/*!
+  \brief Looks configuration up in baseline, returns 0 when not found.
+*/
+static double baseline_of(FILE* baseline, const char* kernel, size_t block, const char* alignment)
+{
+    char line[160];
+    rewind(baseline);
+    while (fgets(line, sizeof(line), baseline) != NULL)
+    {
+        char backend_name[16], kernel_name[32], alignment_name[24];
+        unsigned long block_size;
+        double ticks;
+        if (line[0] == '#' ||
+            sscanf(line, "%15s %31s %lu %23s %lf", backend_name, kernel_name, &block_size, alignment_name, &ticks) != 5)
+            continue;
+        if (strcmp(backend_name, BACKEND) == 0 && strcmp(kernel_name, kernel) == 0 &&
+            block_size == block && strcmp(alignment_name, alignment) == 0)
+            return ticks;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    FILE* baseline = NULL;
+    if (argc > 1)
+    {
+        baseline = fopen(argv[1], "r");
+        if (baseline == NULL)
+        {
+            printf("cannot open baseline %s\n", argv[1]);
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < sizeof(in_buffer); ++i)
+        in_buffer[i] = (int8_t)(i * 37 + 11);
+#if defined(__XTENSA__)
+    ConverterMeterReset(&meter, METER_CHANNELS);
+    AE_SETCBEGIN0(in_buffer);
+    AE_SETCEND0(in_buffer + sizeof(in_buffer));
+#endif
+
+    printf("# backend kernel block alignment %s/sample\n", UT_BENCH_UNIT);
+    uint32_t regressions = 0;
+    for (size_t k = 0; k < sizeof(KERNELS) / sizeof(KERNELS[0]); ++k)
+    {
+        for (size_t b = 0; b < sizeof(BLOCK_SIZES) / sizeof(BLOCK_SIZES[0]); ++b)
+        {
+            // odd count goes through the tail handling of the kernels
+            for (size_t odd = 0; odd < 2; ++odd)
+            {
+                const size_t block = BLOCK_SIZES[b] + odd;
+                for (size_t a = 0; a < sizeof(ALIGNMENTS) / sizeof(ALIGNMENTS[0]); ++a)
+                {
+                    KernelCall call;
+                    call.kernel = &KERNELS[k];
+                    call.in = in_buffer + (a == 1 ? KERNELS[k].in_align : 0);
+                    call.out = out_buffer + (a == 2 ? KERNELS[k].out_align : 0);
+                    call.n_samples = block;
+                    const double ticks = ut_bench(call, block);
+                    printf("%s %s %u %s %.3f", BACKEND, KERNELS[k].name, (unsigned)block, ALIGNMENTS[a], ticks);
+
+                    const double reference = baseline != NULL ? baseline_of(baseline, KERNELS[k].name, block, ALIGNMENTS[a]) : 0;
+                    if (reference != 0 && ticks > reference * BASELINE_TOLERANCE)
+                    {
+                        printf("  # REGRESSION, baseline %.3f", reference);
+                        ++regressions;
+                    }
+                    printf("\n");
+                }
+            }
+        }
+    }
+    if (baseline != NULL)
+    {
+        fclose(baseline);
+        printf("# %u regressions against %s\n", regressions, argv[1]);
+    }
+    return regressions != 0;
+}
@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of crc32.h and crc32_circular_buffer.h against a bitwise reference.
+  Covers the check values, every length and misalignment around the 4-byte slices
+  and the 64-byte PCLMUL blocks, fragmented updates and CircularBuffer contents
+  split at the wrap point, behind queued reads and with a hidden tail.
+  Throughput is printed per path: CRC-32 fragments below 64 bytes always run on
+  the table, longer ones on PCLMUL when built with -mpclmul -msse4.1, CRC-32C on
+  the SSE4.2 instruction when built with -msse4.2. Build without them for the
+  table throughput of long buffers.
+
+  g++ -DUT -O2 -msse4.2 -mpclmul -I<stubs> -I.. crc32_test.cc ../crc32.c
+  g++ -DUT -O2 -I<stubs> -I.. crc32_test.cc ../crc32.c
+*/
+
+#include <stdlib.h>
+#include "adsp_std_defs.h"
+#include "crc32.h"
+#include "crc32_circular_buffer.h"
+#include "ut_bench.h"
+#include "ut_check.h"
+
+using namespace dsp_fw;
+
+static const uint32_t CRC32_POLY = 0xEDB88320;
+static const uint32_t CRC32C_POLY = 0x82F63B78;
+static const uint32_t DATA_SIZE = 1 << 16;
+
+static uint8_t data[DATA_SIZE + 16];
+
+static uint32_t reference_crc(uint32_t poly, const uint8_t* bytes, uint32_t len)
+{
+    uint32_t crc = 0xFFFFFFFF;
+    for (uint32_t i = 0; i < len; ++i)
+    {
+        crc ^= bytes[i];
+        for (uint32_t bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+    }
+    return ~crc;
+}
+
+static void test_check_values()
+{
+    const uint8_t* check = reinterpret_cast<const uint8_t*>("123456789");
+    UT_CHECK(CalculateCrc32(check, 9) == 0xCBF43926);
+    UT_CHECK(CalculateCrc32c(check, 9) == 0xE3069283);
+    UT_CHECK(CalculateCrc32(NULL, 0) == 0);
+    UT_CHECK(CalculateCrc32c(NULL, 0) == 0);
+
+    uint32_t mismatches = 0;
+    for (uint32_t len = 0; len <= 300; ++len)
+    {
+        for (uint32_t offset = 0; offset < 8; ++offset)
+        {
+            mismatches += CalculateCrc32(data + offset, len) != reference_crc(CRC32_POLY, data + offset, len);
+            mismatches += CalculateCrc32c(data + offset, len) != reference_crc(CRC32C_POLY, data + offset, len);
+        }
+    }
+    UT_CHECK(mismatches == 0);
+    UT_CHECK(CalculateCrc32(data, DATA_SIZE) == reference_crc(CRC32_POLY, data, DATA_SIZE));
+    UT_CHECK(CalculateCrc32c(data, DATA_SIZE) == reference_crc(CRC32C_POLY, data, DATA_SIZE));
+}
+
+static void test_fragments()
+{
+    const uint32_t len = 4000;
+    const uint32_t crc32_whole = CalculateCrc32(data, len);
+    const uint32_t crc32c_whole = CalculateCrc32c(data, len);
+    uint32_t mismatches = 0;
+    for (uint32_t round = 0; round < 200; ++round)
+    {
+        // random split points, including empty fragments
+        uint32_t crc32 = Crc32Init();
+        uint32_t crc32c = Crc32Init();
+        uint32_t done = 0;
+        while (done < len)
+        {
+            uint32_t fragment = (uint32_t)rand() % (round < 100 ? 70 : 700);
+            fragment = min(fragment, len - done);
+            crc32 = Crc32Update(crc32, data + done, fragment);
+            crc32c = Crc32cUpdate(crc32c, data + done, fragment);
+            done += fragment;
+        }
+        mismatches += Crc32Finalize(crc32) != crc32_whole;
+        mismatches += Crc32Finalize(crc32c) != crc32c_whole;
+    }
+    UT_CHECK(mismatches == 0);
+}
+
+/*!
+  \brief Returns reference CRC of the readable data: count elements from start, wrapping at logical size.
+*/
+template <class T>
+static uint32_t reference_of_ring(uint32_t poly, const T* ring, size_t logical_size, size_t start, size_t count)
+{
+    static uint8_t linear[DATA_SIZE];
+    size_t bytes = 0;
+    for (size_t idx = 0; idx < count; ++idx)
+    {
+        const T& element = ring[(start + idx) % logical_size];
+        memcpy(linear + bytes, &element, sizeof(T));
+        bytes += sizeof(T);
+    }
+    return reference_crc(poly, linear, (uint32_t)bytes);
+}
+
+static void test_circular_buffer()
+{
+    static int32_t ring[97];
+    memcpy(ring, data, sizeof(ring));
+    const size_t size = sizeof(ring) / sizeof(ring[0]);
+
+    uint32_t mismatches = 0;
+    for (size_t read_position = 0; read_position < size; read_position += 7)
+    {
+        for (size_t data_size = 0; data_size <= size; data_size += 5)
+        {
+            // wrapped whenever read_position + data_size passes the end
+            CircularBuffer<int32_t> buffer(Array<int32_t>(ring, size), read_position, data_size);
+            mismatches += CalculateCrc32OfBuffer(buffer) != reference_of_ring(CRC32_POLY, ring, size, read_position, data_size);
+            mismatches += CalculateCrc32cOfBuffer(buffer) != reference_of_ring(CRC32C_POLY, ring, size, read_position, data_size);
+        }
+    }
+    // full buffer starting in the middle
+    CircularBuffer<int32_t> full(Array<int32_t>(ring, size), 50, size);
+    mismatches += CalculateCrc32OfBuffer(full) != reference_of_ring(CRC32_POLY, ring, size, 50, size);
+    UT_CHECK(mismatches == 0);
+
+    // data queued for reading is skipped, the rest is covered across the wrap
+    CircularBuffer<int32_t> queued(Array<int32_t>(ring, size), 80, 40);
+    Array<int32_t> readable;
+    UT_CHECK(queued.GetReadableBuffer(&readable, 10) == ADSP_SUCCESS);
+    UT_CHECK(queued.GetDataSize() == 30);
+    UT_CHECK(CalculateCrc32OfBuffer(queued) == reference_of_ring(CRC32_POLY, ring, size, 90, 30));
+
+    // writer hid the tail behind position 90, readable data wraps at the logical size
+    CircularBuffer<int32_t> hidden(Array<int32_t>(ring, size), 0, 0);
+    Array<int32_t> chunk;
+    UT_CHECK(hidden.GetWriteableBuffer(&chunk, 90) == ADSP_SUCCESS);
+    UT_CHECK(hidden.WriteCommit(90, true) == ADSP_SUCCESS);
+    chunk.Detach();
+    UT_CHECK(hidden.GetReadableBuffer(&chunk, 60) == ADSP_SUCCESS);
+    UT_CHECK(hidden.ReadCommit(60, true) == ADSP_SUCCESS);
+    chunk.Detach();
+    UT_CHECK(hidden.GetWriteableBuffer(&chunk, 20) == ADSP_SUCCESS);
+    UT_CHECK(hidden.logical_size() == 90);
+    UT_CHECK(hidden.WriteCommit(20, true) == ADSP_SUCCESS);
+    UT_CHECK(hidden.GetDataSize() == 50);
+    UT_CHECK(CalculateCrc32OfBuffer(hidden) == reference_of_ring(CRC32_POLY, ring, 90, 60, 50));
+    UT_CHECK(CalculateCrc32cOfBuffer(hidden) == reference_of_ring(CRC32C_POLY, ring, 90, 60, 50));
+}
+
+struct CrcCall
+{
+    uint32_t (*update)(uint32_t, uint8_t const*, uint32_t);
+    uint32_t fragment;
+    uint32_t crc;
+    void operator()()
+    {
+        for (uint32_t done = 0; done < DATA_SIZE; done += fragment)
+            crc = update(crc, data + done, min(fragment, DATA_SIZE - done));
+    }
+};
+
+static const char* crc32_path(uint32_t fragment)
+{
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+    return fragment >= 64 ? "pclmul" : "table";
+#else
+    (void)fragment;
+    return "table";
+#endif
+}
+
+static const char* crc32c_path()
+{
+#if defined(__SSE4_2__)
+    return "sse4.2";
+#else
+    return "table";
+#endif
+}
+
+static void test_throughput()
+{
+    static const uint32_t FRAGMENTS[] = { 16, 48, 256, 4096 };
+    for (uint32_t f = 0; f < sizeof(FRAGMENTS) / sizeof(FRAGMENTS[0]); ++f)
+    {
+        CrcCall crc32 = { Crc32Update, FRAGMENTS[f], Crc32Init() };
+        CrcCall crc32c = { Crc32cUpdate, FRAGMENTS[f], Crc32Init() };
+        const double crc32_ticks = ut_bench(crc32, DATA_SIZE);
+        const double crc32c_ticks = ut_bench(crc32c, DATA_SIZE);
+        printf("fragment %4u: CRC-32 %-6s %6.3f %s/byte, CRC-32C %-6s %6.3f %s/byte\n", FRAGMENTS[f],
+               crc32_path(FRAGMENTS[f]), crc32_ticks, UT_BENCH_UNIT, crc32c_path(), crc32c_ticks, UT_BENCH_UNIT);
+    }
+}
+
+int main()
+{
+    srand(1);
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+        data[i] = (uint8_t)rand();
+    test_check_values();
+    test_fragments();
+    test_circular_buffer();
+    test_throughput();
+    return ut_result();
+}
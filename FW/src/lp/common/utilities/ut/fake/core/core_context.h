@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host stand-in for the core context used by ut tests, threads always run with
+  interrupts enabled.
+*/
+
+#ifndef ADSP_FW_UTILITIES_UT_FAKE_CORE_CONTEXT_H
+#define ADSP_FW_UTILITIES_UT_FAKE_CORE_CONTEXT_H
+
+#include <stddef.h>
+
+static inline size_t _xtos_get_intlevel()
+{
+    return 0;
+}
+
+#endif // ADSP_FW_UTILITIES_UT_FAKE_CORE_CONTEXT_H
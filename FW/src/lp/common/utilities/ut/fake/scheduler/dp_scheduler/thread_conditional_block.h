@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host stand-in for the DP scheduler blockade, used by ut tests of code which
+  blocks a ThreadedTask. There is no other task to switch to, so the blockade
+  calls ut_scheduler_step, defined by the test, until the flag holds the value.
+  The step plays the other tasks and interrupts, e.g. pushes data or ticks a
+  TimingWheel.
+*/
+
+#ifndef ADSP_FW_UTILITIES_UT_FAKE_THREAD_CONDITIONAL_BLOCK_H
+#define ADSP_FW_UTILITIES_UT_FAKE_THREAD_CONDITIONAL_BLOCK_H
+
+#include <stdint.h>
+
+typedef void (*UtSchedulerStep)(void* context);
+
+extern UtSchedulerStep ut_scheduler_step;
+extern void* ut_scheduler_context;
+
+class BlockCurrentThreadedTask
+{
+public:
+    BlockCurrentThreadedTask(volatile uint32_t* flag, uint32_t value)
+    {
+        while (*flag != value)
+            ut_scheduler_step(ut_scheduler_context);
+    }
+};
+
+#endif // ADSP_FW_UTILITIES_UT_FAKE_THREAD_CONDITIONAL_BLOCK_H
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of fft.h transforms against a direct DFT computed in double.
+  Every supported size is checked for forward error, inverse round trip and the
+  packed layout of real transforms. Float errors are allowed to grow with the
+  number of stages, Q1.31 errors are log2(n) LSB of the 1 / n scaled result.
+  Cost per transform is printed for every size, averaged over a forward and
+  an inverse transform so the data stays in range; build with -O2 for it.
+
+  g++ -DUT -O2 -I<stubs> -I.. fft_test.cc ../fft.cc -lm
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include "fft.h"
+#include "ut_bench.h"
+#include "ut_check.h"
+
+static const double Q31_ONE = 2147483648.0;
+
+static ComplexF32 input[FFT_MAX_SIZE];
+static double dft_re[FFT_MAX_SIZE];
+static double dft_im[FFT_MAX_SIZE];
+
+static uint32_t log2_of(uint32_t n)
+{
+    uint32_t bits = 0;
+    while ((1U << bits) < n)
+        ++bits;
+    return bits;
+}
+
+static void dft(uint32_t n, bool real_input)
+{
+    for (uint32_t k = 0; k < n; ++k)
+    {
+        double re = 0, im = 0;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            // reduce i * k first so the angle keeps full precision
+            const double angle = -2 * M_PI * (double)((uint64_t)i * k % n) / n;
+            const double in_im = real_input ? 0.0 : input[i].im;
+            re += input[i].re * cos(angle) - in_im * sin(angle);
+            im += input[i].re * sin(angle) + in_im * cos(angle);
+        }
+        dft_re[k] = re;
+        dft_im[k] = im;
+    }
+}
+
+static void test_complex(uint32_t n)
+{
+    static ComplexF32 data_f[FFT_MAX_SIZE];
+    static ComplexQ31 data_q[FFT_MAX_SIZE];
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        input[i].re = (float)(rand() / (double)RAND_MAX - 0.5);
+        input[i].im = (float)(rand() / (double)RAND_MAX - 0.5);
+        data_f[i] = input[i];
+        data_q[i].re = (int32_t)(input[i].re * Q31_ONE);
+        data_q[i].im = (int32_t)(input[i].im * Q31_ONE);
+    }
+    dft(n, false);
+
+    const double float_bound = 1.5e-6 * log2_of(n);
+    const double q31_bound = log2_of(n) * n / Q31_ONE;
+    UT_CHECK(fft_complex_f32(data_f, n) == ADSP_SUCCESS);
+    UT_CHECK(fft_complex_q31(data_q, n) == ADSP_SUCCESS);
+    double error_f = 0, error_q = 0;
+    for (uint32_t k = 0; k < n; ++k)
+    {
+        error_f = fmax(error_f, fmax(fabs(data_f[k].re - dft_re[k]), fabs(data_f[k].im - dft_im[k])));
+        error_q = fmax(error_q, fmax(fabs(data_q[k].re / Q31_ONE * n - dft_re[k]),
+                                     fabs(data_q[k].im / Q31_ONE * n - dft_im[k])));
+    }
+
+    UT_CHECK(ifft_complex_f32(data_f, n) == ADSP_SUCCESS);
+    UT_CHECK(ifft_complex_q31(data_q, n) == ADSP_SUCCESS);
+    double round_trip_f = 0, round_trip_q = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        round_trip_f = fmax(round_trip_f, fmax(fabs(data_f[i].re - input[i].re), fabs(data_f[i].im - input[i].im)));
+        // Q1.31 forward + inverse returns x / n
+        round_trip_q = fmax(round_trip_q, fmax(fabs(data_q[i].re / Q31_ONE * n - input[i].re),
+                                               fabs(data_q[i].im / Q31_ONE * n - input[i].im)));
+    }
+    printf("complex n=%4u: f32 %.1e round trip %.1e, q31 %.1e round trip %.1e\n",
+           n, error_f, round_trip_f, error_q, round_trip_q);
+    UT_CHECK(error_f <= float_bound);
+    UT_CHECK(round_trip_f <= 1e-6);
+    UT_CHECK(error_q <= q31_bound);
+    UT_CHECK(round_trip_q <= q31_bound);
+}
+
+static void test_real(uint32_t n)
+{
+    static float data_f[FFT_MAX_SIZE];
+    static int32_t data_q[FFT_MAX_SIZE];
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        input[i].re = (float)(rand() / (double)RAND_MAX - 0.5);
+        input[i].im = 0.0f;
+        data_f[i] = input[i].re;
+        data_q[i] = (int32_t)(input[i].re * Q31_ONE);
+    }
+    dft(n, true);
+
+    const double float_bound = 1.5e-6 * log2_of(n);
+    const double q31_bound = log2_of(n) * n / Q31_ONE;
+    UT_CHECK(fft_real_f32(data_f, n) == ADSP_SUCCESS);
+    UT_CHECK(fft_real_q31(data_q, n) == ADSP_SUCCESS);
+    // X[0] and X[n / 2] are real and packed into the first two values
+    double error_f = fmax(fabs(data_f[0] - dft_re[0]), fabs(data_f[1] - dft_re[n / 2]));
+    double error_q = fmax(fabs(data_q[0] / Q31_ONE * n - dft_re[0]), fabs(data_q[1] / Q31_ONE * n - dft_re[n / 2]));
+    for (uint32_t k = 1; k < n / 2; ++k)
+    {
+        error_f = fmax(error_f, fmax(fabs(data_f[2 * k] - dft_re[k]), fabs(data_f[2 * k + 1] - dft_im[k])));
+        error_q = fmax(error_q, fmax(fabs(data_q[2 * k] / Q31_ONE * n - dft_re[k]),
+                                     fabs(data_q[2 * k + 1] / Q31_ONE * n - dft_im[k])));
+    }
+
+    UT_CHECK(ifft_real_f32(data_f, n) == ADSP_SUCCESS);
+    UT_CHECK(ifft_real_q31(data_q, n) == ADSP_SUCCESS);
+    double round_trip_f = 0, round_trip_q = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        round_trip_f = fmax(round_trip_f, fabs(data_f[i] - input[i].re));
+        round_trip_q = fmax(round_trip_q, fabs(data_q[i] / Q31_ONE * n - input[i].re));
+    }
+    printf("real    n=%4u: f32 %.1e round trip %.1e, q31 %.1e round trip %.1e\n",
+           n, error_f, round_trip_f, error_q, round_trip_q);
+    UT_CHECK(error_f <= float_bound);
+    UT_CHECK(round_trip_f <= 1e-6);
+    UT_CHECK(error_q <= q31_bound);
+    UT_CHECK(round_trip_q <= q31_bound);
+}
+
+static void test_invalid_sizes()
+{
+    static ComplexF32 data[FFT_MAX_SIZE * 2];
+    UT_CHECK(fft_complex_f32(data, 100) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(fft_complex_f32(data, FFT_MIN_SIZE / 2) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(fft_complex_f32(data, FFT_MAX_SIZE * 2) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(fft_real_f32(&data[0].re, 0) == ADSP_ERROR_INVALID_PARAM);
+}
+
+enum TransformKind
+{
+    COMPLEX_F32,
+    COMPLEX_Q31,
+    REAL_F32,
+    REAL_Q31,
+    TRANSFORM_KINDS
+};
+
+struct RoundTrip
+{
+    TransformKind kind;
+    uint32_t n;
+    void* data;
+    void operator()()
+    {
+        switch (kind)
+        {
+        case COMPLEX_F32:
+            fft_complex_f32((ComplexF32*)data, n);
+            ifft_complex_f32((ComplexF32*)data, n);
+            break;
+        case COMPLEX_Q31:
+            fft_complex_q31((ComplexQ31*)data, n);
+            ifft_complex_q31((ComplexQ31*)data, n);
+            break;
+        case REAL_F32:
+            fft_real_f32((float*)data, n);
+            ifft_real_f32((float*)data, n);
+            break;
+        default:
+            fft_real_q31((int32_t*)data, n);
+            ifft_real_q31((int32_t*)data, n);
+            break;
+        }
+    }
+};
+
+static void test_cost()
+{
+    static ComplexF32 data_f[FFT_MAX_SIZE];
+    static ComplexQ31 data_q[FFT_MAX_SIZE];
+    static const char* const NAMES[] = { "complex f32", "complex q31", "real f32", "real q31" };
+    printf("%s per transform (per n * log2(n)):\n", UT_BENCH_UNIT);
+    for (uint32_t n = FFT_MIN_SIZE; n <= FFT_MAX_SIZE; n *= 2)
+    {
+        printf("n=%4u:", n);
+        for (uint32_t kind = 0; kind < TRANSFORM_KINDS; ++kind)
+        {
+            // float round trips keep the data in range, the cost of Q1.31 ones does not depend on it
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                data_f[i].re = (float)(rand() / (double)RAND_MAX - 0.5);
+                data_f[i].im = (float)(rand() / (double)RAND_MAX - 0.5);
+                data_q[i].re = (int32_t)(data_f[i].re * Q31_ONE);
+                data_q[i].im = (int32_t)(data_f[i].im * Q31_ONE);
+            }
+            const bool q31 = kind == COMPLEX_Q31 || kind == REAL_Q31;
+            RoundTrip round_trip = { (TransformKind)kind, n, q31 ? (void*)data_q : (void*)data_f };
+            const double ticks = ut_bench(round_trip, 2);
+            printf("  %s %9.1f (%5.2f)", NAMES[kind], ticks, ticks / (n * log2_of(n)));
+        }
+        printf("\n");
+    }
+}
+
+int main()
+{
+    srand(1);
+    for (uint32_t n = FFT_MIN_SIZE; n <= FFT_MAX_SIZE; n *= 2)
+    {
+        test_complex(n);
+        test_real(n);
+    }
+    test_invalid_sizes();
+    test_cost();
+    return ut_result();
+}
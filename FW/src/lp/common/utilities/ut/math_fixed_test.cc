@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of math_fixed.h against double references.
+  Errors are measured over random and edge arguments in LSB of the result format and
+  compared with the bounds documented in math_fixed.h, Q1.15 functions exhaustively.
+  Batch variants have to be bit-exact with the scalar functions. Throughput is printed
+  next to the float batch variants of math_fw.h.
+
+  g++ -DUT -O2 -I<stubs> -I.. math_fixed_test.cc ../math_fixed.cc ../math_fw_v.cc -lm
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include "math_fixed.h"
+#include "math_fw.h"
+#include "ut_bench.h"
+#include "ut_check.h"
+
+// scalar helper normally provided by math_fw.cc
+float fabsf_fw(float n)
+{
+    return fabsf(n);
+}
+
+static const double Q31_ONE = 2147483648.0;
+static const double Q26_ONE = 67108864.0;
+static const uint32_t RANDOM_POINTS = 200000;
+
+static uint32_t random_u32()
+{
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand() ^ ((uint32_t)rand() << 31);
+}
+
+/*!
+  \brief Distance of two angles in LSB, +1 and -1 (Q1.31 fractions of pi) are the same angle.
+*/
+static double angle_error(int32_t angle, double reference)
+{
+    double error = fabs(angle - reference);
+    return fmin(error, 2 * Q31_ONE - error);
+}
+
+static void test_log_exp()
+{
+    double log_error = 0, exp_error = 0;
+    for (uint32_t i = 0; i < RANDOM_POINTS; ++i)
+    {
+        const uint32_t frac_bits = i % 32;
+        const uint32_t x = random_u32() >> (i % 29);
+        if (x == 0)
+            continue;
+        const double log_ref = log2((double)x / ldexp(1.0, frac_bits)) * Q26_ONE;
+        // values within 1 LSB of 32.0 saturate
+        if (log_ref < INT32_MAX)
+            log_error = fmax(log_error, fabs(log2_fx(x, frac_bits) - log_ref));
+
+        const int32_t e = (int32_t)random_u32();
+        const double exp_ref = exp2(e / Q26_ONE) * ldexp(1.0, frac_bits);
+        const uint32_t value = exp2_fx(e, frac_bits);
+        if (exp_ref >= UINT32_MAX)
+            UT_CHECK(value == UINT32_MAX);
+        else
+            exp_error = fmax(exp_error, fabs(value - exp_ref) / (1.0 + exp_ref * ldexp(1.0, -29)));
+    }
+    printf("log2_fx %.2f LSB, exp2_fx %.2f of (1 LSB + 2^-29 relative)\n", log_error, exp_error);
+    UT_CHECK(log_error <= 1.0);
+    UT_CHECK(exp_error <= 1.0);
+    UT_CHECK(log2_fx(0, 0) == INT32_MIN);
+    UT_CHECK(log2_fx(UINT32_MAX, 0) == INT32_MAX);
+    UT_CHECK(log2_fx(1U << 31, 31) == 0);
+    UT_CHECK(exp2_fx(0, 16) == 65536);
+
+    double pow_error = 0;
+    for (uint32_t i = 0; i < RANDOM_POINTS; ++i)
+    {
+        // gains around unity, UQ16.16, exponents within +-8
+        const uint32_t base = 1 + (random_u32() >> 12);
+        const int32_t exponent = (int32_t)(random_u32() >> 12) - (1 << 19);
+        const double real_exponent = exponent / 65536.0;
+        const double ref = pow(base / 65536.0, real_exponent) * 65536.0;
+        if (ref >= UINT32_MAX)
+            continue;
+        const double bound = 1.0 + ref * (ldexp(1.0, -29) + fabs(real_exponent) * ldexp(1.0, -26));
+        pow_error = fmax(pow_error, fabs(pow_fx(base, exponent, 16) - ref) / bound);
+    }
+    printf("pow_fx %.2f of documented bound\n", pow_error);
+    UT_CHECK(pow_error <= 1.0);
+    UT_CHECK(pow_fx(12345, 0, 16) == 65536);
+    UT_CHECK(pow_fx(0, 65536, 16) == 0);
+}
+
+static void test_sqrt()
+{
+    double error = 0;
+    for (uint32_t i = 0; i < RANDOM_POINTS; ++i)
+    {
+        const int32_t x = (int32_t)(random_u32() >> (1 + i % 31));
+        const double ref = sqrt(x / Q31_ONE) * Q31_ONE;
+        error = fmax(error, fabs(sqrt_q31(x) - ref));
+    }
+    double error_q15 = 0;
+    for (int32_t x = 0; x <= INT16_MAX; ++x)
+        error_q15 = fmax(error_q15, fabs(sqrt_q15((int16_t)x) - sqrt(x / 32768.0) * 32768.0));
+    printf("sqrt_q31 %.2f LSB, sqrt_q15 %.2f LSB\n", error, error_q15);
+    UT_CHECK(error <= 1.0);
+    UT_CHECK(error_q15 <= 1.0);
+    UT_CHECK(sqrt_q31(-5) == 0);
+    UT_CHECK(sqrt_q15(-5) == 0);
+}
+
+static void test_trig()
+{
+    double sin_error = 0, cos_error = 0;
+    for (uint32_t i = 0; i < RANDOM_POINTS; ++i)
+    {
+        // random angles plus the neighbourhood of every octant boundary
+        const int32_t angle = (i < 4096) ? (int32_t)((i >> 9) << 28) + (int32_t)(i & 511) - 256
+                                         : (int32_t)random_u32();
+        const double radians = M_PI * angle / Q31_ONE;
+        sin_error = fmax(sin_error, fabs(sin_q31(angle) - fmin(sin(radians) * Q31_ONE, INT32_MAX)));
+        cos_error = fmax(cos_error, fabs(cos_q31(angle) - fmin(cos(radians) * Q31_ONE, INT32_MAX)));
+    }
+    double sin_error_q15 = 0, cos_error_q15 = 0;
+    for (int32_t angle = INT16_MIN; angle <= INT16_MAX; ++angle)
+    {
+        const double radians = M_PI * angle / 32768.0;
+        sin_error_q15 = fmax(sin_error_q15, fabs(sin_q15((int16_t)angle) - fmin(sin(radians) * 32768.0, INT16_MAX)));
+        cos_error_q15 = fmax(cos_error_q15, fabs(cos_q15((int16_t)angle) - fmin(cos(radians) * 32768.0, INT16_MAX)));
+    }
+    printf("sin_q31 %.2f cos_q31 %.2f sin_q15 %.2f cos_q15 %.2f LSB\n",
+           sin_error, cos_error, sin_error_q15, cos_error_q15);
+    UT_CHECK(sin_error <= 3.0);
+    UT_CHECK(cos_error <= 3.0);
+    UT_CHECK(sin_error_q15 <= 1.0);
+    UT_CHECK(cos_error_q15 <= 1.0);
+
+    double atan2_error = 0;
+    for (uint32_t i = 0; i < RANDOM_POINTS; ++i)
+    {
+        // small vectors too, where the octant ratio is coarse
+        const int32_t y = (int32_t)random_u32() >> (i % 31);
+        const int32_t x = (int32_t)random_u32() >> ((i / 31) % 31);
+        if (x == 0 && y == 0)
+            continue;
+        atan2_error = fmax(atan2_error, angle_error(atan2_q31(y, x), atan2((double)y, (double)x) / M_PI * Q31_ONE));
+    }
+    double atan_error = 0;
+    for (uint32_t i = 0; i < RANDOM_POINTS; ++i)
+    {
+        const int32_t x = (int32_t)random_u32();
+        atan_error = fmax(atan_error, fabs(atan_q31(x) - atan(x / Q31_ONE) / M_PI * Q31_ONE));
+    }
+    printf("atan2_q31 %.2f atan_q31 %.2f LSB\n", atan2_error, atan_error);
+    UT_CHECK(atan2_error <= 2.0);
+    UT_CHECK(atan_error <= 2.0);
+    UT_CHECK(atan2_q31(0, 0) == 0);
+    UT_CHECK(atan2_q31(0, -1) == INT32_MIN);
+    UT_CHECK(atan2_q31(1, 0) == 0x40000000);
+}
+
+static void test_batch()
+{
+    static uint32_t in_u[1024];
+    static int32_t in_a[1024], in_b[1024], out[1024];
+    static int16_t in_16[1024], out_16[1024];
+    for (uint32_t i = 0; i < 1024; ++i)
+    {
+        in_u[i] = random_u32();
+        in_a[i] = (int32_t)random_u32();
+        in_b[i] = (int32_t)random_u32();
+        in_16[i] = (int16_t)random_u32();
+    }
+    uint32_t mismatches = 0;
+    log2_fx_v(out, in_u, 1024, 20);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out[i] != log2_fx(in_u[i], 20);
+    exp2_fx_v((uint32_t*)out, in_a, 1024, 8);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += (uint32_t)out[i] != exp2_fx(in_a[i], 8);
+    pow_fx_v((uint32_t*)out, in_u, in_b, 1024, 16);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += (uint32_t)out[i] != pow_fx(in_u[i], in_b[i], 16);
+    sqrt_q31_v(out, in_a, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out[i] != sqrt_q31(in_a[i]);
+    sin_q31_v(out, in_a, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out[i] != sin_q31(in_a[i]);
+    cos_q31_v(out, in_a, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out[i] != cos_q31(in_a[i]);
+    atan2_q31_v(out, in_a, in_b, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out[i] != atan2_q31(in_a[i], in_b[i]);
+    sqrt_q15_v(out_16, in_16, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out_16[i] != sqrt_q15(in_16[i]);
+    sin_q15_v(out_16, in_16, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out_16[i] != sin_q15(in_16[i]);
+    cos_q15_v(out_16, in_16, 1024);
+    for (uint32_t i = 0; i < 1024; ++i)
+        mismatches += out_16[i] != cos_q15(in_16[i]);
+    UT_CHECK(mismatches == 0);
+}
+
+static const size_t BENCH_POINTS = 1024;
+static int32_t bench_fixed_in[BENCH_POINTS];
+static int32_t bench_fixed_in2[BENCH_POINTS];
+static int32_t bench_fixed_out[BENCH_POINTS];
+static float bench_float_in[BENCH_POINTS];
+static float bench_float_out[BENCH_POINTS];
+
+enum BenchFunction
+{
+    BENCH_LOG,
+    BENCH_EXP,
+    BENCH_SQRT,
+    BENCH_SIN,
+    BENCH_ATAN,
+    BENCH_FUNCTIONS_COUNT
+};
+
+struct FixedCall
+{
+    BenchFunction function;
+    void operator()()
+    {
+        switch (function)
+        {
+        case BENCH_LOG: log2_fx_v(bench_fixed_out, (const uint32_t*)bench_fixed_in, BENCH_POINTS, 31); break;
+        case BENCH_EXP: exp2_fx_v((uint32_t*)bench_fixed_out, bench_fixed_in, BENCH_POINTS, 16); break;
+        case BENCH_SQRT: sqrt_q31_v(bench_fixed_out, bench_fixed_in, BENCH_POINTS); break;
+        case BENCH_SIN: sin_q31_v(bench_fixed_out, bench_fixed_in, BENCH_POINTS); break;
+        default: atan2_q31_v(bench_fixed_out, bench_fixed_in, bench_fixed_in2, BENCH_POINTS); break;
+        }
+    }
+};
+
+struct FloatCall
+{
+    BenchFunction function;
+    void operator()()
+    {
+        switch (function)
+        {
+        case BENCH_LOG: logf_fw_v(bench_float_out, bench_float_in, BENCH_POINTS); break;
+        case BENCH_EXP: expf_fw_v(bench_float_out, bench_float_in, BENCH_POINTS); break;
+        case BENCH_SQRT: sqrtf_fw_v(bench_float_out, bench_float_in, BENCH_POINTS); break;
+        case BENCH_SIN: sinf_fw_v(bench_float_out, bench_float_in, BENCH_POINTS); break;
+        default: atanf_fw_v(bench_float_out, bench_float_in, BENCH_POINTS); break;
+        }
+    }
+};
+
+static void test_throughput()
+{
+    static const char* const NAMES[] = { "log2_fx/logf", "exp2_fx/expf", "sqrt_q31/sqrtf", "sin_q31/sinf", "atan2_q31/atanf" };
+    for (uint32_t i = 0; i < BENCH_POINTS; ++i)
+    {
+        bench_fixed_in[i] = (int32_t)(random_u32() >> 1) + 1;
+        bench_fixed_in2[i] = (int32_t)random_u32();
+        bench_float_in[i] = 0.01f + (float)i;
+    }
+    for (uint32_t f = 0; f < BENCH_FUNCTIONS_COUNT; ++f)
+    {
+        FixedCall fixed_call = { (BenchFunction)f };
+        FloatCall float_call = { (BenchFunction)f };
+        printf("%-16s fixed %6.2f float %6.2f %s per value\n", NAMES[f],
+               ut_bench(fixed_call, BENCH_POINTS), ut_bench(float_call, BENCH_POINTS), UT_BENCH_UNIT);
+    }
+}
+
+int main()
+{
+    srand(1);
+    test_log_exp();
+    test_sqrt();
+    test_trig();
+    test_batch();
+    test_throughput();
+    return ut_result();
+}
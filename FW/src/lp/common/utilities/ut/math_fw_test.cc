@@ -0,0 +1,420 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of math_fw batch variants and accuracy tiers against libm.
+  Errors are measured over dense sweeps and compared with the bounds documented
+  in math_fw.h, special values follow C99 (Annex F) where math_fw.h does not say otherwise.
+  Throughput of batch variants and of the accuracy tiers is printed next to the
+  scalar functions: math_fw ones on Xtensa, libm ones on host (math_fw.cc is not
+  built for host). -O3 lets the
+  compiler vectorize the batch loops. FMA contraction (e.g. -march=native) changes
+  rounding of the polynomials, the documented ULP bounds are for separate mul/add.
+
+  g++ -DUT -O3 -I<stubs> -I.. math_fw_test.cc ../math_fw_v.cc ../math_fw_tiers.cc -lm
+*/
+
+#include <math.h>
+#include "math_fw.h"
+#include "ut_bench.h"
+#include "ut_check.h"
+
+// scalar helper normally provided by math_fw.cc
+float fabsf_fw(float n)
+{
+    return fabsf(n);
+}
+
+static const double MATH_LOG10E = 0.434294481903251828;
+static const size_t SWEEP_POINTS = 1000000;
+static float sweep_in[SWEEP_POINTS];
+static float sweep_out[SWEEP_POINTS];
+
+typedef void (*BatchFunction)(float* out, const float* in, size_t n);
+
+static double ulp_of(double value)
+{
+    int exponent = 0;
+    frexp(value, &exponent);
+    return ldexp(1.0, exponent - 24);
+}
+
+static void fill_sweep(float lo, float hi, bool log_scale)
+{
+    for (size_t i = 0; i < SWEEP_POINTS; ++i)
+    {
+        const double t = (double)i / (SWEEP_POINTS - 1);
+        sweep_in[i] = log_scale ? (float)(lo * pow((double)hi / lo, t)) : (float)(lo + ((double)hi - lo) * t);
+    }
+}
+
+/*!
+  \brief Returns max error of function over [lo, hi], in ULP of the reference or absolute.
+*/
+static double max_error(BatchFunction function, double (*reference)(double),
+                        float lo, float hi, bool log_scale, bool in_ulp)
+{
+    fill_sweep(lo, hi, log_scale);
+    function(sweep_out, sweep_in, SWEEP_POINTS);
+    double worst = 0;
+    for (size_t i = 0; i < SWEEP_POINTS; ++i)
+    {
+        const double ref = reference(sweep_in[i]);
+        if (ref == 0)
+            continue;
+        const double error = fabs(sweep_out[i] - ref);
+        worst = fmax(worst, in_ulp ? error / ulp_of(ref) : error);
+    }
+    return worst;
+}
+
+static void test_accuracy()
+{
+    const double exp_ulp = max_error(expf_fw_v, exp, -87.0f, 88.7f, false, true);
+    // around 1 is where log has the smallest results
+    const double log_ulp = fmax(max_error(logf_fw_v, log, 1e-37f, 3e38f, true, true),
+                                max_error(logf_fw_v, log, 0.5f, 2.0f, false, true));
+    const double log10_ulp = fmax(max_error(log10f_fw_v, log10, 1e-37f, 3e38f, true, true),
+                                  max_error(log10f_fw_v, log10, 0.5f, 2.0f, false, true));
+    const double sqrt_ulp = max_error(sqrtf_fw_v, sqrt, 1e-37f, 3e38f, true, true);
+    const double sin_ulp = max_error(sinf_fw_v, sin, -3.14159f, 3.14159f, false, true);
+    const double cos_ulp = max_error(cosf_fw_v, cos, -3.14159f, 3.14159f, false, true);
+    const double sin_abs = max_error(sinf_fw_v, sin, -8192.0f, 8192.0f, false, false);
+    const double cos_abs = max_error(cosf_fw_v, cos, -8192.0f, 8192.0f, false, false);
+    const double atan_ulp = max_error(atanf_fw_v, atan, -1e6f, 1e6f, false, true);
+    printf("exp %.2f log %.2f log10 %.2f sqrt %.2f sin %.2f cos %.2f atan %.2f ulp, "
+           "sin %.2g cos %.2g abs\n",
+           exp_ulp, log_ulp, log10_ulp, sqrt_ulp, sin_ulp, cos_ulp, atan_ulp, sin_abs, cos_abs);
+    UT_CHECK(exp_ulp <= 1.0);
+    UT_CHECK(log_ulp <= 1.0);
+    UT_CHECK(log10_ulp <= 2.0);
+    UT_CHECK(sqrt_ulp <= 1.0);
+    UT_CHECK(sin_ulp <= 1.5);
+    UT_CHECK(cos_ulp <= 1.5);
+    UT_CHECK(sin_abs <= 8e-8);
+    UT_CHECK(cos_abs <= 8e-8);
+    UT_CHECK(atan_ulp <= 3.0);
+
+    // 10^x, |x| <= 10 within (4 + |x * ln(10)|) ULP
+    static float bases[SWEEP_POINTS];
+    fill_sweep(-10.0f, 10.0f, false);
+    for (size_t i = 0; i < SWEEP_POINTS; ++i)
+        bases[i] = 10.0f;
+    powf_fw_v(sweep_out, bases, sweep_in, SWEEP_POINTS);
+    double pow_ulp = 0;
+    for (size_t i = 0; i < SWEEP_POINTS; ++i)
+    {
+        const double ref = pow(10.0, sweep_in[i]);
+        const double error = fabs(sweep_out[i] - ref) / ulp_of(ref);
+        UT_CHECK(error <= 4.0 + fabs(sweep_in[i] * log(10.0)));
+        pow_ulp = fmax(pow_ulp, error);
+    }
+    printf("pow10 %.2f ulp\n", pow_ulp);
+}
+
+static bool same(float value, float expected)
+{
+    return (isnan(value) && isnan(expected)) || value == expected;
+}
+
+static void test_special_values()
+{
+    const float inf = INFINITY;
+    const float nan = NAN;
+    float out[8];
+
+    const float exp_in[] = { nan, -inf, inf, -88.0f, -100.0f, 89.0f, 0.0f };
+    const float exp_ref[] = { nan, 0.0f, inf, 0.0f, 0.0f, inf, 1.0f };
+    expf_fw_v(out, exp_in, 7);
+    for (size_t i = 0; i < 7; ++i)
+        UT_CHECK(same(out[i], exp_ref[i]));
+
+    const float log_in[] = { nan, -1.0f, 0.0f, 1e-40f, inf, 1.0f };
+    const float log_ref[] = { nan, nan, -inf, -inf, inf, 0.0f };
+    logf_fw_v(out, log_in, 6);
+    for (size_t i = 0; i < 6; ++i)
+        UT_CHECK(same(out[i], log_ref[i]));
+
+    const float sqrt_in[] = { -1.0f, 0.0f, 1e-40f, inf, 4.0f };
+    const float sqrt_ref[] = { nan, 0.0f, 0.0f, inf, 2.0f };
+    sqrtf_fw_v(out, sqrt_in, 5);
+    for (size_t i = 0; i < 5; ++i)
+        UT_CHECK(same(out[i], sqrt_ref[i]));
+
+    const float pow_base[] = { 0.0f, 0.0f, 0.0f, -2.0f, -2.0f, -2.0f, 1.0f, nan };
+    const float pow_exp[] = { 0.0f, 2.0f, -1.0f, 2.0f, 3.0f, 0.5f, nan, 0.0f };
+    const float pow_ref[] = { 1.0f, 0.0f, inf, 4.0f, -8.0f, nan, 1.0f, 1.0f };
+    powf_fw_v(out, pow_base, pow_exp, 8);
+    for (size_t i = 0; i < 8; ++i)
+        UT_CHECK(same(out[i], pow_ref[i]) || fabsf(out[i] - pow_ref[i]) <= 4 * ulp_of(pow_ref[i]));
+    const float big_base[] = { -1.0f, -1.0f, nan };
+    const float big_exp[] = { 16777216.0f, 16777215.0f, 2.0f };
+    powf_fw_v(out, big_base, big_exp, 3);
+    UT_CHECK(out[0] == 1.0f);
+    UT_CHECK(out[1] == -1.0f);
+    UT_CHECK(isnan(out[2]));
+
+    // huge arguments are saturated, non-finite ones have no sine
+    const float trig_in[] = { inf, -inf, nan, 1e10f, -3e38f, 4194304.0f };
+    sinf_fw_v(out, trig_in, 6);
+    for (size_t i = 0; i < 3; ++i)
+        UT_CHECK(isnan(out[i]));
+    for (size_t i = 3; i < 6; ++i)
+        UT_CHECK(fabsf(out[i]) <= 1.0f);
+    cosf_fw_v(out, trig_in, 6);
+    for (size_t i = 0; i < 3; ++i)
+        UT_CHECK(isnan(out[i]));
+    for (size_t i = 3; i < 6; ++i)
+        UT_CHECK(fabsf(out[i]) <= 1.0f);
+}
+
+typedef float (*ScalarFunction)(float arg);
+
+/*!
+  \brief Returns max error of scalar function over [lo, hi], relative or absolute.
+*/
+static double max_tier_error(ScalarFunction function, double (*reference)(double),
+                             float lo, float hi, bool log_scale, bool relative)
+{
+    fill_sweep(lo, hi, log_scale);
+    double worst = 0;
+    for (size_t i = 0; i < SWEEP_POINTS; ++i)
+    {
+        const double ref = reference(sweep_in[i]);
+        const double error = fabs(function(sweep_in[i]) - ref);
+        worst = fmax(worst, relative ? error / fabs(ref) : error);
+    }
+    return worst;
+}
+
+static double max_log_excess(ScalarFunction function, float lo, float hi)
+{
+    // outside of [0.01, 100] half ULP of the result comes on top of the tier bound
+    fill_sweep(lo, hi, true);
+    double worst = 0;
+    for (size_t i = 0; i < SWEEP_POINTS; ++i)
+    {
+        const double ref = log((double)sweep_in[i]);
+        worst = fmax(worst, fabs(function(sweep_in[i]) - ref) - 0.5 * ulp_of(ref));
+    }
+    return worst;
+}
+
+static void test_tiers()
+{
+    UT_CHECK(max_tier_error(expf_fw_fast, exp, -87.0f, 88.0f, false, true) <= 1e-4);
+    UT_CHECK(max_tier_error(expf_fw_medium, exp, -87.0f, 88.0f, false, true) <= 3.6e-6);
+
+    const double log_fast = max_tier_error(logf_fw_fast, log, 0.01f, 100.0f, true, false);
+    const double log_medium = max_tier_error(logf_fw_medium, log, 0.01f, 100.0f, true, false);
+    const double log_fast_full = max_log_excess(logf_fw_fast, 1.2e-38f, 3.4e38f);
+    const double log_medium_full = max_log_excess(logf_fw_medium, 1.2e-38f, 3.4e38f);
+    printf("log fast %.3g medium %.3g, full range above half ULP fast %.3g medium %.3g\n",
+           log_fast, log_medium, log_fast_full, log_medium_full);
+    UT_CHECK(log_fast <= 2e-5);
+    UT_CHECK(log_medium <= 9.3e-7);
+    UT_CHECK(log_fast_full <= 2e-5);
+    UT_CHECK(log_medium_full <= 9.3e-7);
+    UT_CHECK(max_tier_error(log10f_fw_fast, log10, 0.01f, 100.0f, true, false) <= 2e-5 * MATH_LOG10E);
+    UT_CHECK(max_tier_error(log10f_fw_medium, log10, 0.01f, 100.0f, true, false) <= 9.3e-7 * MATH_LOG10E);
+
+    UT_CHECK(max_tier_error(sinf_fw_fast, sin, -1000.0f, 1000.0f, false, false) <= 3.1e-4);
+    UT_CHECK(max_tier_error(sinf_fw_medium, sin, -1000.0f, 1000.0f, false, false) <= 1.2e-6);
+    UT_CHECK(max_tier_error(cosf_fw_fast, cos, -1000.0f, 1000.0f, false, false) <= 3.1e-4);
+    UT_CHECK(max_tier_error(cosf_fw_medium, cos, -1000.0f, 1000.0f, false, false) <= 1.2e-6);
+    UT_CHECK(max_tier_error(atanf_fw_fast, atan, -1e4f, 1e4f, false, false) <= 1.4e-4);
+    UT_CHECK(max_tier_error(atanf_fw_medium, atan, -1e4f, 1e4f, false, false) <= 5.3e-7);
+
+    UT_CHECK(logf_fw_fast(0.0f) == -INFINITY);
+    UT_CHECK(isnan(logf_fw_medium(-1.0f)));
+    UT_CHECK(isnan(expf_fw_fast(NAN)));
+    UT_CHECK(isnan(expf_fw_medium(NAN)));
+    UT_CHECK(isnan(log10f_fw_fast(NAN)));
+
+    // pow tiers resolve special cases like powf_fw_v
+    typedef float (*PowFunction)(float base, float exponent);
+    const PowFunction pow_tiers[] = { powf_fw_fast, powf_fw_medium };
+    for (size_t t = 0; t < 2; ++t)
+    {
+        UT_CHECK(fabsf(pow_tiers[t](-2.0f, 2.0f) - 4.0f) <= 4e-4f);
+        UT_CHECK(fabsf(pow_tiers[t](-2.0f, 3.0f) + 8.0f) <= 8e-4f);
+        UT_CHECK(isnan(pow_tiers[t](-2.0f, 0.5f)));
+        UT_CHECK(isnan(pow_tiers[t](NAN, 2.0f)));
+        UT_CHECK(isnan(pow_tiers[t](2.0f, NAN)));
+        UT_CHECK(pow_tiers[t](NAN, 0.0f) == 1.0f);
+        UT_CHECK(pow_tiers[t](0.0f, 0.0f) == 1.0f);
+        UT_CHECK(pow_tiers[t](1.0f, NAN) == 1.0f);
+        // exp tiers saturate at the smallest normal float
+        UT_CHECK(pow_tiers[t](0.0f, 2.0f) <= 1.2e-38f);
+    }
+
+    const ScalarFunction trig_tiers[] = { sinf_fw_fast, sinf_fw_medium, cosf_fw_fast, cosf_fw_medium };
+    const float trig_in[] = { INFINITY, -INFINITY, NAN, 1e10f, -3e38f };
+    for (size_t t = 0; t < 4; ++t)
+    {
+        for (size_t i = 0; i < 3; ++i)
+            UT_CHECK(isnan(trig_tiers[t](trig_in[i])));
+        for (size_t i = 3; i < 5; ++i)
+            UT_CHECK(fabsf(trig_tiers[t](trig_in[i])) <= 1.0f);
+    }
+}
+
+#if defined(__XTENSA__)
+#define SCALAR(name) name##_fw
+#else
+#define SCALAR(name) name
+#endif
+
+static const size_t BENCH_POINTS = 1024;
+
+static void fill_bench(float lo, float hi)
+{
+    for (size_t i = 0; i < BENCH_POINTS; ++i)
+        sweep_in[i] = (float)(lo + ((double)hi - lo) * i / (BENCH_POINTS - 1));
+}
+
+struct BatchCall
+{
+    BatchFunction function;
+    void operator()()
+    {
+        function(sweep_out, sweep_in, BENCH_POINTS);
+    }
+};
+
+struct ScalarCall
+{
+    ScalarFunction function;
+    void operator()()
+    {
+        for (size_t i = 0; i < BENCH_POINTS; ++i)
+            sweep_out[i] = function(sweep_in[i]);
+    }
+};
+
+struct PowCall
+{
+    const float* bases;
+    void operator()()
+    {
+        powf_fw_v(sweep_out, bases, sweep_in, BENCH_POINTS);
+    }
+};
+
+struct ScalarPowCall
+{
+    const float* bases;
+    void operator()()
+    {
+        for (size_t i = 0; i < BENCH_POINTS; ++i)
+            sweep_out[i] = SCALAR(powf)(bases[i], sweep_in[i]);
+    }
+};
+
+static void test_throughput()
+{
+    struct Case
+    {
+        const char* name;
+        BatchFunction batch;
+        ScalarFunction scalar;
+        float lo, hi;
+    };
+    const Case cases[] = {
+        { "exp", expf_fw_v, SCALAR(expf), -80.0f, 80.0f },
+        { "log", logf_fw_v, SCALAR(logf), 1e-3f, 1e3f },
+        { "log10", log10f_fw_v, SCALAR(log10f), 1e-3f, 1e3f },
+        { "sqrt", sqrtf_fw_v, SCALAR(sqrtf), 0.0f, 1e3f },
+        { "sin", sinf_fw_v, SCALAR(sinf), -100.0f, 100.0f },
+        { "cos", cosf_fw_v, SCALAR(cosf), -100.0f, 100.0f },
+        { "atan", atanf_fw_v, SCALAR(atanf), -100.0f, 100.0f },
+    };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+    {
+        fill_bench(cases[c].lo, cases[c].hi);
+        BatchCall batch = { cases[c].batch };
+        ScalarCall scalar = { cases[c].scalar };
+        const double batch_ticks = ut_bench(batch, BENCH_POINTS);
+        const double scalar_ticks = ut_bench(scalar, BENCH_POINTS);
+        printf("%-6s batch %6.2f scalar %6.2f %s per value (%.1fx)\n", cases[c].name,
+               batch_ticks, scalar_ticks, UT_BENCH_UNIT, scalar_ticks / batch_ticks);
+    }
+
+    static float bases[BENCH_POINTS];
+    fill_bench(0.1f, 10.0f);
+    for (size_t i = 0; i < BENCH_POINTS; ++i)
+        bases[i] = sweep_in[i];
+    fill_bench(-4.0f, 4.0f);
+    PowCall batch = { bases };
+    ScalarPowCall scalar = { bases };
+    const double batch_ticks = ut_bench(batch, BENCH_POINTS);
+    const double scalar_ticks = ut_bench(scalar, BENCH_POINTS);
+    printf("%-6s batch %6.2f scalar %6.2f %s per value (%.1fx)\n", "pow",
+           batch_ticks, scalar_ticks, UT_BENCH_UNIT, scalar_ticks / batch_ticks);
+}
+
+struct PowTierCall
+{
+    float (*function)(float base, float exponent);
+    const float* bases;
+    void operator()()
+    {
+        for (size_t i = 0; i < BENCH_POINTS; ++i)
+            sweep_out[i] = function(bases[i], sweep_in[i]);
+    }
+};
+
+/*!
+  \brief Prints cost of the accuracy tiers next to the full precision scalar function.
+*/
+static void test_tier_cost()
+{
+    struct Case
+    {
+        const char* name;
+        ScalarFunction full, medium, fast;
+        float lo, hi;
+    };
+    const Case cases[] = {
+        { "exp", SCALAR(expf), expf_fw_medium, expf_fw_fast, -80.0f, 80.0f },
+        { "log", SCALAR(logf), logf_fw_medium, logf_fw_fast, 1e-3f, 1e3f },
+        { "log10", SCALAR(log10f), log10f_fw_medium, log10f_fw_fast, 1e-3f, 1e3f },
+        { "sin", SCALAR(sinf), sinf_fw_medium, sinf_fw_fast, -100.0f, 100.0f },
+        { "cos", SCALAR(cosf), cosf_fw_medium, cosf_fw_fast, -100.0f, 100.0f },
+        { "atan", SCALAR(atanf), atanf_fw_medium, atanf_fw_fast, -100.0f, 100.0f },
+    };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)
+    {
+        fill_bench(cases[c].lo, cases[c].hi);
+        ScalarCall full = { cases[c].full };
+        ScalarCall medium = { cases[c].medium };
+        ScalarCall fast = { cases[c].fast };
+        printf("%-6s full %6.2f medium %6.2f fast %6.2f %s per value\n", cases[c].name,
+               ut_bench(full, BENCH_POINTS), ut_bench(medium, BENCH_POINTS),
+               ut_bench(fast, BENCH_POINTS), UT_BENCH_UNIT);
+    }
+
+    static float bases[BENCH_POINTS];
+    fill_bench(0.1f, 10.0f);
+    for (size_t i = 0; i < BENCH_POINTS; ++i)
+        bases[i] = sweep_in[i];
+    fill_bench(-4.0f, 4.0f);
+    ScalarPowCall full = { bases };
+    PowTierCall medium = { powf_fw_medium, bases };
+    PowTierCall fast = { powf_fw_fast, bases };
+    printf("%-6s full %6.2f medium %6.2f fast %6.2f %s per value\n", "pow",
+           ut_bench(full, BENCH_POINTS), ut_bench(medium, BENCH_POINTS),
+           ut_bench(fast, BENCH_POINTS), UT_BENCH_UNIT);
+}
+
+int main()
+{
+    test_accuracy();
+    test_special_values();
+    test_tiers();
+    test_throughput();
+    test_tier_cost();
+    return ut_result();
+}
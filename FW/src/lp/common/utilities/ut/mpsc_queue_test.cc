@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of MpUtils::MpscQueue under UT, where the sequence counter uses
+  __sync builtins and cache maintenance is a no-op. Producer threads stand in for
+  the cores: each one pushes numbered messages filling the whole slot line, the
+  consumer checks that nothing is lost, duplicated, reordered within a producer
+  or torn. The queue is small, so positions wrap and producers race for every slot.
+
+  g++ -DUT -I<stubs> -I.. mpsc_queue_test.cc -lpthread
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include "mpsc_queue.h"
+#include "ut_check.h"
+
+using namespace MpUtils;
+
+static const uint32_t PRODUCERS = 4;
+static const uint32_t MESSAGES_PER_PRODUCER = 250000;
+static const uint32_t PAYLOAD_WORDS = 10;
+
+struct Message
+{
+    uint32_t producer;
+    uint32_t index;
+    // derived from producer and index, a torn copy does not match
+    uint32_t payload[PAYLOAD_WORDS];
+};
+
+static uint32_t payload_word(uint32_t producer, uint32_t index, uint32_t word)
+{
+    return (producer * 0x9E3779B9U) ^ (index * 0x85EBCA6BU) ^ (word * 0xC2B2AE35U);
+}
+
+DCACHE_ALIGN static MpscQueue<Message, 8> stress_queue;
+DCACHE_ALIGN static MpscQueue<Message, 4> single_queue;
+
+static void* producer_thread(void* context)
+{
+    const uint32_t producer = (uint32_t)(uintptr_t)context;
+    Message message;
+    message.producer = producer;
+    for (uint32_t index = 0; index < MESSAGES_PER_PRODUCER;)
+    {
+        message.index = index;
+        for (uint32_t word = 0; word < PAYLOAD_WORDS; ++word)
+            message.payload[word] = payload_word(producer, index, word);
+        if (stress_queue.Push(message) == ADSP_SUCCESS)
+            ++index;
+        else
+            sched_yield();
+    }
+    return NULL;
+}
+
+static void test_single_thread()
+{
+    Message message = {};
+    UT_CHECK(single_queue.Pop(&message) == ADSP_SIMPLE_QUEUE_EMPTY);
+
+    // several rounds so sequence numbers of every slot advance past the capacity
+    for (uint32_t round = 0; round < 3; ++round)
+    {
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            message.index = round * 4 + i;
+            UT_CHECK(single_queue.Push(message) == ADSP_SUCCESS);
+        }
+        UT_CHECK(single_queue.Push(message) == ADSP_SIMPLE_QUEUE_FULL);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            UT_CHECK(single_queue.Pop(&message) == ADSP_SUCCESS);
+            UT_CHECK(message.index == round * 4 + i);
+        }
+        UT_CHECK(single_queue.Pop(&message) == ADSP_SIMPLE_QUEUE_EMPTY);
+    }
+
+    UT_CHECK(single_queue.Push(message) == ADSP_SUCCESS);
+    single_queue.Reset();
+    UT_CHECK(single_queue.Pop(&message) == ADSP_SIMPLE_QUEUE_EMPTY);
+}
+
+static void test_producers_race()
+{
+    pthread_t threads[PRODUCERS];
+    for (uint32_t producer = 0; producer < PRODUCERS; ++producer)
+        UT_CHECK(pthread_create(&threads[producer], NULL, producer_thread, (void*)(uintptr_t)producer) == 0);
+
+    uint32_t next_index[PRODUCERS] = {};
+    uint32_t received = 0;
+    uint32_t order_errors = 0;
+    uint32_t torn = 0;
+    while (received < PRODUCERS * MESSAGES_PER_PRODUCER)
+    {
+        Message message;
+        if (stress_queue.Pop(&message) != ADSP_SUCCESS)
+        {
+            sched_yield();
+            continue;
+        }
+        ++received;
+        if (message.producer >= PRODUCERS || message.index != next_index[message.producer])
+        {
+            ++order_errors;
+            continue;
+        }
+        ++next_index[message.producer];
+        for (uint32_t word = 0; word < PAYLOAD_WORDS; ++word)
+            torn += message.payload[word] != payload_word(message.producer, message.index, word);
+    }
+    for (uint32_t producer = 0; producer < PRODUCERS; ++producer)
+        pthread_join(threads[producer], NULL);
+
+    Message message;
+    printf("received %u messages, %u out of order, %u torn words\n", received, order_errors, torn);
+    UT_CHECK(order_errors == 0);
+    UT_CHECK(torn == 0);
+    for (uint32_t producer = 0; producer < PRODUCERS; ++producer)
+        UT_CHECK(next_index[producer] == MESSAGES_PER_PRODUCER);
+    UT_CHECK(stress_queue.Pop(&message) == ADSP_SIMPLE_QUEUE_EMPTY);
+}
+
+int main()
+{
+    test_single_thread();
+    test_producers_race();
+    return ut_result();
+}
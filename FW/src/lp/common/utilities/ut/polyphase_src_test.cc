@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of PolyphaseSrc against the ideal resampler.
+  A sine resampled without error is the same sine sampled at the output rate, so the
+  output is least-squares fitted with a*sin + b*cos (which absorbs the filter delay)
+  and the residual gives SNR of the converter. Stream length has to follow the ratio
+  exactly and output must not depend on how the stream is split into blocks.
+  Cost of every preset and quality is printed per input frame, build with -O2 for
+  representative numbers.
+
+  g++ -DUT -O2 -I<stubs> -I.. polyphase_src_test.cc ../polyphase_src.cc -lm
+*/
+
+#include <math.h>
+#include <string.h>
+#include "polyphase_src.h"
+#include "ut_bench.h"
+#include "ut_check.h"
+
+using namespace dsp_fw;
+
+static const size_t CHANNELS = 2;
+static const size_t IN_FRAMES = 48000;
+
+static int32_t in_samples[CHANNELS * IN_FRAMES];
+static int32_t out_samples[CHANNELS * 3 * IN_FRAMES + 16];
+static int32_t ref_samples[CHANNELS * 3 * IN_FRAMES + 16];
+
+struct SineFit
+{
+    double amplitude;
+    double snr_db;
+};
+
+static size_t run(PolyphaseSrc::Preset preset, PolyphaseSrc::Quality quality, int32_t drift_ppm,
+                  size_t block_frames, int32_t* out)
+{
+    PolyphaseSrc src;
+    UT_CHECK(src.Init(preset, quality, CHANNELS, PolyphaseSrc::SRC_FORMAT_32B,
+                      PolyphaseSrc::SRC_FORMAT_32B) == ADSP_SUCCESS);
+    if (drift_ppm != 0)
+        UT_CHECK(src.SetDrift(drift_ppm) == ADSP_SUCCESS);
+
+    size_t total = 0;
+    for (size_t i = 0; i < IN_FRAMES; i += block_frames)
+    {
+        const size_t frames = IN_FRAMES - i < block_frames ? IN_FRAMES - i : block_frames;
+        size_t produced = 0;
+        UT_CHECK(src.Process(in_samples + CHANNELS * i, frames, out + CHANNELS * total,
+                             src.GetMaxOutputFrames(frames), &produced) == ADSP_SUCCESS);
+        total += produced;
+    }
+    return total;
+}
+
+static SineFit fit_sine(const int32_t* out, size_t frames, double frequency)
+{
+    // skip filter warm-up and the last frames
+    const size_t first = 200;
+    const size_t last = frames - 10;
+    double ss = 0, sc = 0, cc = 0, ys = 0, yc = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        const double s = sin(2 * M_PI * frequency * i);
+        const double c = cos(2 * M_PI * frequency * i);
+        const double y = out[CHANNELS * i] / 2147483648.0;
+        ss += s * s; sc += s * c; cc += c * c; ys += y * s; yc += y * c;
+    }
+    const double det = ss * cc - sc * sc;
+    const double a = (ys * cc - yc * sc) / det;
+    const double b = (yc * ss - ys * sc) / det;
+    double signal = 0, noise = 0;
+    for (size_t i = first; i < last; ++i)
+    {
+        const double model = a * sin(2 * M_PI * frequency * i) + b * cos(2 * M_PI * frequency * i);
+        const double y = out[CHANNELS * i] / 2147483648.0;
+        signal += model * model;
+        noise += (y - model) * (y - model);
+    }
+    SineFit fit = { sqrt(a * a + b * b), 10 * log10(signal / noise) };
+    return fit;
+}
+
+static void test_sine(PolyphaseSrc::Preset preset, PolyphaseSrc::Quality quality,
+                      double in_rate, double out_rate, double tone, int32_t drift_ppm,
+                      double min_snr_db)
+{
+    for (size_t i = 0; i < IN_FRAMES; ++i)
+    {
+        in_samples[CHANNELS * i] = (int32_t)(0.5 * 2147483647.0 * sin(2 * M_PI * tone * i / in_rate));
+        in_samples[CHANNELS * i + 1] = -in_samples[CHANNELS * i];
+    }
+
+    // odd block size exercises phase carried over between calls
+    const size_t frames = run(preset, quality, drift_ppm, 97, out_samples);
+    const double expected = IN_FRAMES * out_rate / in_rate / (1.0 + drift_ppm * 1e-6);
+    UT_CHECK(fabs(frames - expected) <= 1.0);
+
+    const SineFit fit = fit_sine(out_samples, frames, tone * (1.0 + drift_ppm * 1e-6) / out_rate);
+    printf("preset %d quality %d tone %.0f Hz: %zu frames, amplitude %.4f, SNR %.1f dB\n",
+           preset, quality, tone, frames, fit.amplitude, fit.snr_db);
+    UT_CHECK(fabs(fit.amplitude - 0.5) < 0.001);
+    UT_CHECK(fit.snr_db >= min_snr_db);
+
+    for (size_t i = 0; i < frames; ++i)
+        UT_CHECK(out_samples[CHANNELS * i + 1] == -out_samples[CHANNELS * i] ||
+                 out_samples[CHANNELS * i + 1] == -out_samples[CHANNELS * i] - 1 ||
+                 out_samples[CHANNELS * i + 1] == -out_samples[CHANNELS * i] + 1);
+
+    // single block gives bit-exact same stream
+    const size_t ref_frames = run(preset, quality, drift_ppm, IN_FRAMES, ref_samples);
+    UT_CHECK(ref_frames == frames);
+    UT_CHECK(memcmp(ref_samples, out_samples, CHANNELS * frames * sizeof(int32_t)) == 0);
+}
+
+static void test_stopband()
+{
+    // 23 kHz is above 44.1 kHz Nyquist and has to be rejected
+    for (size_t i = 0; i < IN_FRAMES; ++i)
+        in_samples[CHANNELS * i] = in_samples[CHANNELS * i + 1] =
+            (int32_t)(0.5 * 2147483647.0 * sin(2 * M_PI * 23000.0 * i / 48000.0));
+    const size_t frames = run(PolyphaseSrc::SRC_48K_TO_44K1, PolyphaseSrc::SRC_QUALITY_HIGH, 0, 97, out_samples);
+    double energy = 0;
+    for (size_t i = 200; i < frames; ++i)
+        energy += (double)out_samples[CHANNELS * i] * out_samples[CHANNELS * i];
+    const double rms = sqrt(energy / (frames - 200)) / 2147483648.0;
+    printf("48k -> 44.1k 23 kHz residual rms %.5f\n", rms);
+    UT_CHECK(rms < 0.01);
+}
+
+static void test_api()
+{
+    PolyphaseSrc src;
+    size_t produced = 0;
+    UT_CHECK(src.Process(in_samples, 1, out_samples, 16, &produced) == ADSP_INVALID_REQUEST);
+    UT_CHECK(src.Init(PolyphaseSrc::SRC_PRESETS_COUNT, PolyphaseSrc::SRC_QUALITY_LOW, 2,
+                      PolyphaseSrc::SRC_FORMAT_32B, PolyphaseSrc::SRC_FORMAT_32B) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(src.Init(PolyphaseSrc::SRC_48K_TO_16K, PolyphaseSrc::SRC_QUALITY_LOW, PolyphaseSrc::MAX_CHANNELS + 1,
+                      PolyphaseSrc::SRC_FORMAT_32B, PolyphaseSrc::SRC_FORMAT_32B) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(src.Init(PolyphaseSrc::SRC_48K_TO_16K, PolyphaseSrc::SRC_QUALITY_LOW, 2,
+                      PolyphaseSrc::SRC_FORMAT_32B, PolyphaseSrc::SRC_FORMAT_32B) == ADSP_SUCCESS);
+    UT_CHECK(src.SetDrift(10) == ADSP_INVALID_REQUEST);
+    UT_CHECK(src.Process(in_samples, 30, out_samples, src.GetMaxOutputFrames(30) - 1, &produced) ==
+             ADSP_OUT_OF_RESOURCES);
+}
+
+struct SrcBlock
+{
+    PolyphaseSrc* src;
+    size_t frames;
+
+    void operator()()
+    {
+        size_t produced = 0;
+        src->Process(in_samples, frames, out_samples, src->GetMaxOutputFrames(frames), &produced);
+    }
+};
+
+static void test_cost()
+{
+    static const char* const PRESET_NAMES[] = { "48k->16k", "16k->48k", "44.1k->48k", "48k->44.1k", "48k->48k" };
+    C_ASSERT(sizeof(PRESET_NAMES) / sizeof(PRESET_NAMES[0]) == PolyphaseSrc::SRC_PRESETS_COUNT);
+    for (size_t i = 0; i < CHANNELS * IN_FRAMES; ++i)
+        in_samples[i] = (int32_t)(i * 2654435761U);
+
+    for (uint32_t preset = 0; preset < PolyphaseSrc::SRC_PRESETS_COUNT; ++preset)
+    {
+        for (uint32_t quality = PolyphaseSrc::SRC_QUALITY_LOW; quality <= PolyphaseSrc::SRC_QUALITY_HIGH; ++quality)
+        {
+            PolyphaseSrc src;
+            UT_CHECK(src.Init((PolyphaseSrc::Preset)preset, (PolyphaseSrc::Quality)quality, CHANNELS,
+                              PolyphaseSrc::SRC_FORMAT_32B, PolyphaseSrc::SRC_FORMAT_32B) == ADSP_SUCCESS);
+            // 20 ms blocks at the input rate of the 48 kHz presets
+            SrcBlock block = { &src, 960 };
+            printf("cost %-10s quality %u: %.1f %s per input frame (%zu channels)\n", PRESET_NAMES[preset], quality,
+                   ut_bench(block, block.frames), UT_BENCH_UNIT, CHANNELS);
+        }
+    }
+}
+
+int main()
+{
+    test_api();
+    test_sine(PolyphaseSrc::SRC_48K_TO_16K, PolyphaseSrc::SRC_QUALITY_LOW, 48000, 16000, 1000, 0, 100);
+    test_sine(PolyphaseSrc::SRC_16K_TO_48K, PolyphaseSrc::SRC_QUALITY_LOW, 16000, 48000, 1000, 0, 78);
+    test_sine(PolyphaseSrc::SRC_44K1_TO_48K, PolyphaseSrc::SRC_QUALITY_LOW, 44100, 48000, 1000, 0, 72);
+    test_sine(PolyphaseSrc::SRC_44K1_TO_48K, PolyphaseSrc::SRC_QUALITY_HIGH, 44100, 48000, 1000, 0, 82);
+    test_sine(PolyphaseSrc::SRC_44K1_TO_48K, PolyphaseSrc::SRC_QUALITY_HIGH, 44100, 48000, 10000, 0, 78);
+    test_sine(PolyphaseSrc::SRC_48K_TO_44K1, PolyphaseSrc::SRC_QUALITY_HIGH, 48000, 44100, 5000, 0, 85);
+    test_sine(PolyphaseSrc::SRC_48K_TO_48K, PolyphaseSrc::SRC_QUALITY_HIGH, 48000, 48000, 1000, 100, 82);
+    test_stopband();
+    test_cost();
+    return ut_result();
+}
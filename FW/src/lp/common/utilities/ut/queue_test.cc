@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of SimpleQueue against a reference FIFO (std::deque).
+  Random sequences of Push, Pop, Peek, Remove, RemoveLazy, RemoveLazyAt and the
+  bulk operations are applied to queues of every small size, contents and count
+  are compared after each step. Slots reported by PushGetSlot() are kept per element,
+  so removal through a handle is exercised next to tombstones and compaction.
+
+  g++ -DUT -I<stubs> -I.. queue_test.cc ../queue.cc
+*/
+
+#include <stdlib.h>
+#include <algorithm>
+#include <deque>
+#include <map>
+#include "queue.h"
+#include "ut_check.h"
+
+static const uint32_t MAX_SIZE = 12;
+static const uint32_t STEPS = 20000;
+// bulk push does not report slots
+static const uint32_t NO_SLOT = UINT32_MAX;
+
+struct Model
+{
+    std::deque<uintptr_t> fifo;
+    // slot reported by PushGetSlot() for every queued element
+    std::map<uintptr_t, uint32_t> slots;
+};
+
+static const void* as_element(uintptr_t value)
+{
+    return (const void*)value;
+}
+
+static void erase(Model* model, uintptr_t value)
+{
+    model->fifo.erase(std::find(model->fifo.begin(), model->fifo.end(), value));
+    model->slots.erase(value);
+}
+
+static bool matches(const SimpleQueue* queue, const Model& model)
+{
+    if (GetElementsCount(queue) != model.fifo.size())
+        return false;
+    const void* elements[MAX_SIZE];
+    const uint32_t count = PeekN(queue, elements, MAX_SIZE);
+    if (count != model.fifo.size())
+        return false;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        if (elements[i] != as_element(model.fifo[i]))
+            return false;
+    }
+    return true;
+}
+
+static uint32_t run(uint32_t size, uint32_t seed, uint32_t* stale_handles)
+{
+    srand(seed);
+    SimpleQueue queue;
+    const void* buffer[MAX_SIZE];
+    QueueInit(&queue, buffer, size);
+    Model model;
+    uintptr_t next = 1;
+    uint32_t failures = 0;
+
+    for (uint32_t step = 0; step < STEPS && failures == 0; ++step)
+    {
+        const void* element = NULL;
+        const int operation = rand() % 9;
+        if (operation < 3)
+        {
+            uint32_t slot = 0;
+            const ErrorCode ec = PushGetSlot(&queue, as_element(next), &slot);
+            failures += (ec == ADSP_SUCCESS) != (model.fifo.size() < size);
+            if (ec == ADSP_SUCCESS)
+            {
+                failures += slot >= size;
+                model.fifo.push_back(next);
+                model.slots[next] = slot;
+            }
+            ++next;
+        }
+        else if (operation == 3)
+        {
+            const ErrorCode ec = Pop(&queue, &element);
+            if (model.fifo.empty())
+            {
+                failures += ec != ADSP_SIMPLE_QUEUE_EMPTY;
+            }
+            else
+            {
+                failures += ec != ADSP_SUCCESS || element != as_element(model.fifo.front());
+                // handle of popped element is stale
+                const uint32_t slot = model.slots[model.fifo.front()];
+                erase(&model, model.fifo.front());
+                if (slot != NO_SLOT)
+                    failures += RemoveLazyAt(&queue, slot, element) != ADSP_NOT_FOUND;
+            }
+        }
+        else if (operation == 4 && !model.fifo.empty())
+        {
+            const uintptr_t value = model.fifo[rand() % model.fifo.size()];
+            failures += RemoveLazy(&queue, as_element(value)) != ADSP_SUCCESS;
+            erase(&model, value);
+            failures += RemoveLazy(&queue, as_element(value)) == ADSP_SUCCESS;
+        }
+        else if (operation == 5 && !model.fifo.empty())
+        {
+            const uintptr_t value = model.fifo[rand() % model.fifo.size()];
+            failures += Remove(&queue, as_element(value)) != ADSP_SUCCESS;
+            erase(&model, value);
+        }
+        else if (operation == 6 && !model.fifo.empty())
+        {
+            const uintptr_t value = model.fifo[rand() % model.fifo.size()];
+            const uint32_t slot = model.slots[value];
+            const ErrorCode ec = (slot == NO_SLOT) ? ADSP_NOT_FOUND : RemoveLazyAt(&queue, slot, as_element(value));
+            if (ec == ADSP_NOT_FOUND)
+            {
+                // no handle, or element was moved by compaction since its push
+                *stale_handles += slot != NO_SLOT;
+                failures += RemoveLazy(&queue, as_element(value)) != ADSP_SUCCESS;
+            }
+            else
+            {
+                failures += ec != ADSP_SUCCESS;
+            }
+            erase(&model, value);
+        }
+        else if (operation == 7)
+        {
+            const void* elements[MAX_SIZE];
+            const uint32_t count = rand() % (size + 1);
+            for (uint32_t i = 0; i < count; ++i)
+                elements[i] = as_element(next + i);
+            const uint32_t pushed = PushN(&queue, elements, count);
+            failures += pushed != std::min<size_t>(count, size - model.fifo.size());
+            for (uint32_t i = 0; i < pushed; ++i)
+            {
+                model.fifo.push_back(next + i);
+                model.slots[next + i] = NO_SLOT;
+            }
+            next += count;
+        }
+        else if (operation == 8)
+        {
+            const void* elements[MAX_SIZE];
+            const uint32_t count = rand() % (size + 1);
+            const uint32_t popped = PopN(&queue, elements, count);
+            failures += popped != std::min<size_t>(count, model.fifo.size());
+            for (uint32_t i = 0; i < popped; ++i)
+            {
+                failures += elements[i] != as_element(model.fifo.front());
+                erase(&model, model.fifo.front());
+            }
+        }
+
+        failures += !matches(&queue, model);
+        if (!model.fifo.empty())
+            failures += Peek(&queue, &element) != ADSP_SUCCESS || element != as_element(model.fifo.front());
+    }
+    return failures;
+}
+
+static void test_invalid_handles()
+{
+    SimpleQueue queue;
+    const void* buffer[4];
+    QueueInit(&queue, buffer, 4);
+    uint32_t slot = 0;
+    UT_CHECK(PushGetSlot(&queue, as_element(1), &slot) == ADSP_SUCCESS);
+    UT_CHECK(RemoveLazyAt(&queue, 4, as_element(1)) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(RemoveLazyAt(&queue, slot, NULL) == ADSP_ERROR_NULL_POINTER_AS_PARAM);
+    UT_CHECK(RemoveLazyAt(&queue, slot, as_element(2)) == ADSP_NOT_FOUND);
+    UT_CHECK(RemoveLazyAt(&queue, slot, as_element(1)) == ADSP_SUCCESS);
+    UT_CHECK(RemoveLazyAt(&queue, slot, as_element(1)) == ADSP_NOT_FOUND);
+    UT_CHECK(IsFree(&queue));
+}
+
+int main()
+{
+    test_invalid_handles();
+    uint32_t stale_handles = 0;
+    for (uint32_t size = 1; size <= MAX_SIZE; ++size)
+    {
+        for (uint32_t seed = 1; seed <= 20; ++seed)
+        {
+            const uint32_t failures = run(size, seed, &stale_handles);
+            if (failures != 0)
+                printf("size %u seed %u: %u mismatches\n", size, seed, failures);
+            UT_CHECK(failures == 0);
+        }
+    }
+    printf("stale handles after compaction: %u\n", stale_handles);
+    return ut_result();
+}
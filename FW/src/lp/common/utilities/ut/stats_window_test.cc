@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of StatsWindow (queue.h) against a brute-force pass over the window.
+  Integer accumulators have to match exactly, including partially filled windows,
+  clear() and values whose squares overflow 32 bits. Floating point accumulators
+  are checked over 2e7 appends of values in [1000, 1001), where plain running
+  sums drift and cancel out the variance.
+
+  g++ -DUT -O2 -I<stubs> -I.. stats_window_test.cc
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <deque>
+#include "queue.h"
+#include "ut_check.h"
+
+using namespace dsp_fw;
+
+/*!
+  \brief Brute-force statistics of the window, in the integer arithmetic of StatsWindow.
+*/
+template<class T, class ACC>
+struct ExactStats
+{
+    explicit ExactStats(const std::deque<T>& window)
+        : sum(), sum_squares(), min_value(window.front()), max_value(window.front())
+    {
+        for (size_t i = 0; i < window.size(); ++i)
+        {
+            const ACC value = static_cast<ACC>(window[i]);
+            sum += value;
+            sum_squares += value * value;
+            min_value = min(min_value, window[i]);
+            max_value = max(max_value, window[i]);
+        }
+        const ACC count = static_cast<ACC>(window.size());
+        mean = sum / count;
+        const ACC mean_squares = sum_squares / count;
+        variance = mean_squares > mean * mean ? mean_squares - mean * mean : ACC();
+    }
+    ACC sum;
+    ACC sum_squares;
+    ACC mean;
+    ACC variance;
+    T min_value;
+    T max_value;
+};
+
+template<class T, size_t N, class ACC>
+static uint32_t check_exact(const StatsWindow<T, N, ACC>& stats, const std::deque<T>& window)
+{
+    if (window.empty())
+        return stats.len() != 0 || stats.sum() != ACC() || stats.mean() != ACC() || stats.variance() != ACC();
+    const ExactStats<T, ACC> expected(window);
+    return stats.len() != window.size() || stats.sum() != expected.sum || stats.mean() != expected.mean ||
+           stats.variance() != expected.variance || stats.min_value() != expected.min_value ||
+           stats.max_value() != expected.max_value;
+}
+
+/*!
+  \brief Appends random values in [low, low + range) and compares every step, clears now and then.
+*/
+template<class T, size_t N, class ACC>
+static void test_integer(T low, uint32_t range)
+{
+    StatsWindow<T, N, ACC> stats;
+    std::deque<T> window;
+    uint32_t mismatches = check_exact(stats, window);
+    for (uint32_t step = 0; step < 20000; ++step)
+    {
+        if (rand() % 1000 == 0)
+        {
+            stats.clear();
+            window.clear();
+        }
+        const T element = static_cast<T>(low + static_cast<T>(static_cast<uint32_t>(rand()) % range));
+        const T expected_out = window.size() == N ? window.front() : T();
+        if (window.size() == N)
+            window.pop_front();
+        window.push_back(element);
+        mismatches += stats.append(element) != expected_out;
+        mismatches += check_exact(stats, window);
+    }
+    UT_CHECK(mismatches == 0);
+}
+
+static void test_wide_squares()
+{
+    // squares need 33 bits, their window sum 36 bits
+    StatsWindow<uint32_t, 16, uint64_t> stats;
+    for (uint32_t i = 0; i < 1000; ++i)
+        stats.append(i % 2 ? 70000 : 0);
+    UT_CHECK(stats.mean() == 35000);
+    UT_CHECK(stats.variance() == 1225000000ull);
+    UT_CHECK(stats.min_value() == 0);
+    UT_CHECK(stats.max_value() == 70000);
+
+    // largest values whose 16 squares still fit in uint64_t
+    StatsWindow<uint32_t, 16, uint64_t> top;
+    std::deque<uint32_t> window;
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        const uint32_t element = (1u << 30) - 1 - (uint32_t)rand() % 1000;
+        if (window.size() == 16)
+            window.pop_front();
+        window.push_back(element);
+        top.append(element);
+        mismatches += check_exact(top, window);
+    }
+    UT_CHECK(mismatches == 0);
+    UT_CHECK(top.variance() > 0);
+}
+
+/*!
+  \brief Runs 2e7 appends of values in [1000, 1001), compares with a double pass over the window.
+*/
+template<class ACC>
+static void test_floating(double tolerance)
+{
+    static const size_t N = 64;
+    static const uint32_t APPENDS = 20000000;
+    StatsWindow<float, N, ACC> stats;
+    float window[N];
+    double worst_mean = 0;
+    double worst_variance = 0;
+    uint32_t extreme_mismatches = 0;
+    for (uint32_t step = 0; step < APPENDS; ++step)
+    {
+        const float element = 1000.0f + static_cast<float>(rand()) / (static_cast<float>(RAND_MAX) + 1.0f);
+        window[step % N] = element;
+        stats.append(element);
+        if (step % 99991 != 0 && step != APPENDS - 1)
+            continue;
+
+        const size_t count = min<size_t>(step + 1, N);
+        double sum = 0;
+        float low = window[0];
+        float high = window[0];
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += window[i];
+            low = min(low, window[i]);
+            high = max(high, window[i]);
+        }
+        const double mean = sum / count;
+        double variance = 0;
+        for (size_t i = 0; i < count; ++i)
+            variance += (window[i] - mean) * (window[i] - mean);
+        variance /= count;
+        worst_mean = max(worst_mean, fabs(static_cast<double>(stats.mean()) - mean));
+        // uniform values, the window variance stays around 1/12
+        worst_variance = max(worst_variance, fabs(static_cast<double>(stats.variance()) - variance) / (variance + 1e-3));
+        extreme_mismatches += stats.min_value() != low || stats.max_value() != high;
+    }
+    printf("%s accumulator: worst mean error %.3g, worst relative variance error %.3g\n",
+           sizeof(ACC) == sizeof(double) ? "double" : "float", worst_mean, worst_variance);
+    UT_CHECK(worst_mean < tolerance * 1000);
+    UT_CHECK(worst_variance < tolerance);
+    UT_CHECK(extreme_mismatches == 0);
+}
+
+int main()
+{
+    srand(1);
+    test_integer<uint32_t, 16, uint64_t>(0, 1u << 20);
+    test_integer<uint32_t, 7, uint64_t>(0, 10);
+    test_integer<uint16_t, 1, uint32_t>(0, 65535);
+    test_integer<int32_t, 5, int64_t>(-1000, 2000);
+    test_wide_squares();
+    test_floating<double>(1e-9);
+    test_floating<float>(1e-3);
+    return ut_result();
+}
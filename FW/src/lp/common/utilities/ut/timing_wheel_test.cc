@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of TimingWheel against a model keeping the due tick of every timer.
+  20 seeds of random Start, re-Start and Cancel calls, also issued from callbacks,
+  with delays spanning all levels; every callback has to come exactly on the due
+  tick and cancelled timers must never fire. Odd seeds start the tick counter
+  right before its wrap, the long seeds park timers beyond MAX_DELAY. Timers at
+  the level boundaries check the cascade deterministically.
+
+  g++ -DUT -O2 -I<stubs> -I.. timing_wheel_test.cc ../timing_wheel.cc
+*/
+
+#include <stdlib.h>
+#include "timing_wheel.h"
+#include "ut_check.h"
+
+using namespace dsp_fw;
+
+static const uint32_t TIMERS = 300;
+static const uint32_t SEEDS = 20;
+static const uint32_t SHORT_TICKS = 1U << 21;
+// long enough for timers parked beyond MAX_DELAY to fire
+static const uint32_t LONG_TICKS = TimingWheel::MAX_DELAY + (1U << 23);
+
+struct ModelTimer
+{
+    WheelTimer timer;
+    // tick counted from the start of the run, when armed
+    uint64_t due;
+    bool armed;
+};
+
+struct Harness
+{
+    TimingWheel* wheel;
+    uint32_t start_ticks;
+    uint64_t elapsed;
+    uint64_t run_ticks;
+    uint32_t random;
+    ModelTimer timers[TIMERS];
+    uint32_t fired;
+    uint32_t misfired;
+};
+
+static Harness harness;
+
+static uint32_t next_random()
+{
+    // xorshift32, cheaper than rand() in the per tick loop
+    uint32_t x = harness.random;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    harness.random = x;
+    return x;
+}
+
+/*!
+  \brief Returns delay in a randomly chosen level, beyond MAX_DELAY only for long runs.
+*/
+static uint32_t random_delay()
+{
+    const uint32_t range = next_random() % (harness.run_ticks > SHORT_TICKS ? 6 : 5);
+    switch (range)
+    {
+    case 0: return next_random() % 3;
+    case 1: return next_random() % TimingWheel::SLOTS;
+    case 2: return next_random() % (TimingWheel::SLOTS * TimingWheel::SLOTS);
+    case 3: return next_random() % (TimingWheel::SLOTS * TimingWheel::SLOTS * TimingWheel::SLOTS);
+    case 4: return next_random() % SHORT_TICKS;
+    default: return TimingWheel::MAX_DELAY + next_random() % (1U << 22);
+    }
+}
+
+static void on_expired(void* context);
+
+static void start(ModelTimer* model, uint32_t delay)
+{
+    harness.wheel->Start(&model->timer, delay, on_expired, model);
+    model->due = harness.elapsed + max(delay, 1U);
+    model->armed = true;
+}
+
+static void cancel(ModelTimer* model)
+{
+    harness.wheel->Cancel(&model->timer);
+    model->armed = false;
+}
+
+static void on_expired(void* context)
+{
+    ModelTimer* model = static_cast<ModelTimer*>(context);
+    harness.fired++;
+    harness.misfired += !model->armed || model->due != harness.elapsed ||
+                        harness.wheel->GetTicks() != (uint32_t)(harness.start_ticks + model->due);
+    model->armed = false;
+    // callbacks may restart themselves and cancel other timers
+    const uint32_t action = next_random() % 8;
+    if (action < 2)
+        start(model, random_delay());
+    else if (action == 2)
+        cancel(&harness.timers[next_random() % TIMERS]);
+}
+
+static void test_random(uint32_t seed)
+{
+    harness.run_ticks = seed % 5 == 0 ? LONG_TICKS : SHORT_TICKS;
+    // odd seeds wrap the tick counter in the middle of the run
+    harness.start_ticks = seed % 2 ? 0U - (uint32_t)(harness.run_ticks / 2) : seed * 12345;
+    harness.elapsed = 0;
+    harness.random = 0x9E3779B9 ^ (seed * 2654435761U);
+    harness.fired = 0;
+    harness.misfired = 0;
+    TimingWheel wheel(harness.start_ticks);
+    harness.wheel = &wheel;
+    for (uint32_t i = 0; i < TIMERS; ++i)
+        harness.timers[i] = ModelTimer();
+
+    for (uint64_t tick = 0; tick < harness.run_ticks; ++tick)
+    {
+        const uint32_t action = next_random() % 64;
+        if (action < 4)
+            start(&harness.timers[next_random() % TIMERS], random_delay());
+        else if (action < 6)
+            cancel(&harness.timers[next_random() % TIMERS]);
+        harness.elapsed++;
+        wheel.Tick();
+    }
+
+    uint32_t missed = 0;
+    uint32_t pending_mismatches = 0;
+    for (uint32_t i = 0; i < TIMERS; ++i)
+    {
+        const ModelTimer& model = harness.timers[i];
+        missed += model.armed && model.due <= harness.elapsed;
+        pending_mismatches += wheel.IsPending(&model.timer) != model.armed;
+    }
+    UT_CHECK(harness.misfired == 0);
+    UT_CHECK(missed == 0);
+    UT_CHECK(pending_mismatches == 0);
+    UT_CHECK(harness.fired > 1000);
+}
+
+struct BoundaryTimer
+{
+    WheelTimer timer;
+    uint64_t fired_at;
+    uint32_t fired_count;
+};
+
+static void on_boundary(void* context)
+{
+    BoundaryTimer* boundary = static_cast<BoundaryTimer*>(context);
+    boundary->fired_at = harness.elapsed;
+    boundary->fired_count++;
+}
+
+/*!
+  \brief Timers on both sides of every level boundary and of MAX_DELAY, started at start_ticks.
+*/
+static void test_boundaries(uint32_t start_ticks)
+{
+    static const uint32_t LEVEL1 = TimingWheel::SLOTS;
+    static const uint32_t LEVEL2 = LEVEL1 * TimingWheel::SLOTS;
+    static const uint32_t LEVEL3 = LEVEL2 * TimingWheel::SLOTS;
+    static const uint32_t MAX_DELAY = TimingWheel::MAX_DELAY;
+    static const uint32_t DELAYS[] = {
+        0, 1, LEVEL1 - 1, LEVEL1, LEVEL1 + 1, LEVEL2 - 1, LEVEL2, LEVEL2 + 1, LEVEL3 - 1, LEVEL3, LEVEL3 + 1,
+        MAX_DELAY - 1, MAX_DELAY, MAX_DELAY + 1, MAX_DELAY + LEVEL1, 2 * MAX_DELAY + 5
+    };
+    static const uint32_t COUNT = sizeof(DELAYS) / sizeof(DELAYS[0]);
+
+    TimingWheel wheel(start_ticks);
+    harness.elapsed = 0;
+    BoundaryTimer timers[COUNT];
+    for (uint32_t i = 0; i < COUNT; ++i)
+    {
+        timers[i].fired_at = 0;
+        timers[i].fired_count = 0;
+        UT_CHECK(wheel.Start(&timers[i].timer, DELAYS[i], on_boundary, &timers[i]) == ADSP_SUCCESS);
+    }
+    while (harness.elapsed < 2ULL * MAX_DELAY + 5 + LEVEL1)
+    {
+        harness.elapsed++;
+        wheel.Tick();
+    }
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < COUNT; ++i)
+    {
+        mismatches += timers[i].fired_count != 1 || timers[i].fired_at != max(DELAYS[i], 1U) ||
+                      wheel.IsPending(&timers[i].timer);
+    }
+    UT_CHECK(mismatches == 0);
+}
+
+static void test_invalid()
+{
+    TimingWheel wheel;
+    WheelTimer timer;
+    UT_CHECK(wheel.Start(NULL, 1, TimingWheel::SignalFlag, NULL) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(wheel.Start(&timer, 1, NULL, NULL) == ADSP_ERROR_INVALID_PARAM);
+    UT_CHECK(!wheel.IsPending(&timer));
+    // cancelling an idle timer has no effect
+    wheel.Cancel(&timer);
+    UT_CHECK(!wheel.IsPending(&timer));
+}
+
+int main()
+{
+    for (uint32_t seed = 0; seed < SEEDS; ++seed)
+        test_random(seed);
+    test_boundaries(0);
+    test_boundaries(0U - TimingWheel::MAX_DELAY / 3);
+    test_invalid();
+    return ut_result();
+}
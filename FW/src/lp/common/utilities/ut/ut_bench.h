@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Timing helper shared by host tests and benchmarks of the utilities, built with -DUT.
+  Ticks are CCOUNT cycles when the program runs on Xtensa (ISS or board) and
+  nanoseconds on host, UT_BENCH_UNIT names the unit for printouts.
+*/
+
+#ifndef ADSP_FW_UTILITIES_UT_BENCH_H
+#define ADSP_FW_UTILITIES_UT_BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(__XTENSA__)
+#include <xtensa/hal.h>
+#define UT_BENCH_UNIT "cycles"
+#else
+#include <time.h>
+#define UT_BENCH_UNIT "ns"
+#endif
+
+// shortest run that is timed, shorter ones are repeated until they take that long
+#define UT_BENCH_MIN_TICKS 2000000
+
+static inline uint64_t ut_bench_ticks(void)
+{
+#if defined(__XTENSA__)
+    static uint32_t last = 0;
+    static uint64_t high = 0;
+    const uint32_t now = xthal_get_ccount();
+    // CCOUNT wraps within seconds
+    high += (uint32_t)(now - last);
+    last = now;
+    return high;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*!
+  \brief Returns ticks per item of op(), best of runs (the least disturbed one).
+  op() processes items_per_call items per call and is called as many times
+  as needed for a run to take UT_BENCH_MIN_TICKS.
+*/
+template<class OP>
+static double ut_bench(OP& op, size_t items_per_call, uint32_t runs = 5)
+{
+    uint32_t calls = 1;
+    for (;;)
+    {
+        const uint64_t start = ut_bench_ticks();
+        for (uint32_t call = 0; call < calls; ++call)
+            op();
+        if (ut_bench_ticks() - start >= UT_BENCH_MIN_TICKS / 4 || calls >= (1u << 24))
+            break;
+        calls *= 2;
+    }
+    calls *= 4;
+
+    double best = 0;
+    for (uint32_t run = 0; run < runs; ++run)
+    {
+        const uint64_t start = ut_bench_ticks();
+        for (uint32_t call = 0; call < calls; ++call)
+            op();
+        const double per_item = (double)(ut_bench_ticks() - start) / ((double)calls * items_per_call);
+        best = (run == 0 || per_item < best) ? per_item : best;
+    }
+    return best;
+}
+
+#endif // ADSP_FW_UTILITIES_UT_BENCH_H
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Minimal checks shared by host tests of the utilities, built with -DUT.
+  Each test is a standalone program, exit code is non-zero when any check failed.
+*/
+
+#ifndef ADSP_FW_UTILITIES_UT_CHECK_H
+#define ADSP_FW_UTILITIES_UT_CHECK_H
+
+#include <stdio.h>
+
+static int ut_failures = 0;
+
+/*!
+  \brief Reports failed condition and keeps going, so one run shows all failures.
+*/
+#define UT_CHECK(cond)                                                          \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+            ++ut_failures;                                                      \
+        }                                                                       \
+    } while (0)
+
+/*!
+  \brief Prints verdict, to be returned from main().
+*/
+static inline int ut_result(void)
+{
+    printf(ut_failures != 0 ? "FAILED (%d checks)\n" : "PASSED\n", ut_failures);
+    return ut_failures != 0;
+}
+
+#endif // ADSP_FW_UTILITIES_UT_CHECK_H
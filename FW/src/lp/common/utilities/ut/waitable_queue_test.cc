@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+/*!
+  \file
+  Host test of WaitableQueue with the blockade of fake/, which runs a scripted
+  scheduler step while Pop() is blocked: the step ticks the TimingWheel and at
+  given steps pushes an element or takes it with a non-blocking Pop() before the
+  woken waiter gets to it. Checks the timeout tick exactly, wake by Push(), a
+  stolen element (the wait goes on for the rest of the original timeout), timeouts
+  beyond TimingWheel::MAX_DELAY and across the tick counter wrap.
+
+  g++ -DUT -O2 -Ifake -I<stubs> -I.. waitable_queue_test.cc ../waitable_queue.cc ../timing_wheel.cc ../queue.cc
+*/
+
+#include "waitable_queue.h"
+#include "scheduler/dp_scheduler/thread_conditional_block.h"
+#include "ut_check.h"
+
+using namespace dsp_fw;
+
+UtSchedulerStep ut_scheduler_step = NULL;
+void* ut_scheduler_context = NULL;
+
+static const uint32_t NEVER = 0xFFFFFFFF;
+
+/*!
+  \brief What happens while the consumer is blocked, step n is the n-th call.
+*/
+struct Script
+{
+    TimingWheel* wheel;
+    WaitableQueue* queue;
+    uint32_t steps;
+    uint32_t push_at[2];
+    uintptr_t push_value[2];
+    // non-blocking Pop() right after the push of this step
+    uint32_t steal_at;
+};
+
+static void run_step(void* context)
+{
+    Script* script = static_cast<Script*>(context);
+    script->steps++;
+    if (script->wheel != NULL)
+        script->wheel->Tick();
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        if (script->steps == script->push_at[i])
+            UT_CHECK(script->queue->Push((const void*)script->push_value[i]) == ADSP_SUCCESS);
+    }
+    if (script->steps == script->steal_at)
+        UT_CHECK(script->queue->Pop(NULL, 0) == ADSP_SUCCESS);
+}
+
+static Script make_script(TimingWheel* wheel, WaitableQueue* queue)
+{
+    Script script = { wheel, queue, 0, { NEVER, NEVER }, { 0, 0 }, NEVER };
+    ut_scheduler_step = run_step;
+    return script;
+}
+
+static void test_timeout(uint32_t start_ticks, uint32_t timeout_ticks)
+{
+    TimingWheel wheel(start_ticks);
+    const void* buffer[4];
+    WaitableQueue queue(buffer, 4, &wheel);
+    Script script = make_script(&wheel, &queue);
+    ut_scheduler_context = &script;
+    const void* element = (const void*)1;
+    UT_CHECK(queue.Pop(&element, timeout_ticks) == ADSP_SIMPLE_QUEUE_EMPTY);
+    UT_CHECK(script.steps == timeout_ticks);
+    UT_CHECK(wheel.GetTicks() - start_ticks == timeout_ticks);
+    UT_CHECK(element == (const void*)1);
+}
+
+static void test_wake_by_push()
+{
+    TimingWheel wheel;
+    const void* buffer[4];
+    WaitableQueue queue(buffer, 4, &wheel);
+    Script script = make_script(&wheel, &queue);
+    ut_scheduler_context = &script;
+    script.push_at[0] = 3;
+    script.push_value[0] = 42;
+    const void* element = NULL;
+    UT_CHECK(queue.Pop(&element, 10) == ADSP_SUCCESS);
+    UT_CHECK(element == (const void*)42);
+    UT_CHECK(script.steps == 3);
+    UT_CHECK(queue.GetElementsCount() == 0);
+
+    // the timer of the finished wait was cancelled, the wheel runs on without it
+    for (uint32_t tick = 0; tick < 100; ++tick)
+        wheel.Tick();
+
+    // timeout beyond anything the wheel keeps without parking
+    script = make_script(&wheel, &queue);
+    script.push_at[0] = 50;
+    script.push_value[0] = 9;
+    UT_CHECK(queue.Pop(&element, 0x80000000) == ADSP_SUCCESS);
+    UT_CHECK(element == (const void*)9);
+    UT_CHECK(script.steps == 50);
+
+    // infinite wait needs no wheel
+    WaitableQueue no_wheel(buffer, 4);
+    script = make_script(NULL, &no_wheel);
+    script.push_at[0] = 5;
+    script.push_value[0] = 7;
+    UT_CHECK(no_wheel.Pop(&element) == ADSP_SUCCESS);
+    UT_CHECK(element == (const void*)7);
+    UT_CHECK(script.steps == 5);
+}
+
+static void test_stolen_element()
+{
+    TimingWheel wheel;
+    const void* buffer[4];
+    WaitableQueue queue(buffer, 4, &wheel);
+    Script script = make_script(&wheel, &queue);
+    ut_scheduler_context = &script;
+
+    // woken waiter finds the queue empty again and waits for the next element
+    script.push_at[0] = 2;
+    script.push_value[0] = 1;
+    script.steal_at = 2;
+    script.push_at[1] = 6;
+    script.push_value[1] = 5;
+    const void* element = NULL;
+    UT_CHECK(queue.Pop(&element, 100) == ADSP_SUCCESS);
+    UT_CHECK(element == (const void*)5);
+    UT_CHECK(script.steps == 6);
+
+    // ... and times out on the original deadline when nothing else comes
+    script = make_script(&wheel, &queue);
+    script.push_at[0] = 2;
+    script.push_value[0] = 1;
+    script.steal_at = 2;
+    element = NULL;
+    UT_CHECK(queue.Pop(&element, 20) == ADSP_SIMPLE_QUEUE_EMPTY);
+    UT_CHECK(script.steps == 20);
+    UT_CHECK(element == NULL);
+}
+
+static void test_non_blocking()
+{
+    TimingWheel wheel;
+    const void* buffer[2];
+    WaitableQueue queue(buffer, 2, &wheel);
+    Script script = make_script(&wheel, &queue);
+    ut_scheduler_context = &script;
+    const void* element = NULL;
+    UT_CHECK(queue.Pop(&element, 0) == ADSP_SIMPLE_QUEUE_EMPTY);
+    UT_CHECK(script.steps == 0);
+    UT_CHECK(queue.Push((const void*)3) == ADSP_SUCCESS);
+    UT_CHECK(queue.Push((const void*)4) == ADSP_SUCCESS);
+    UT_CHECK(queue.Push((const void*)5) == ADSP_SIMPLE_QUEUE_FULL);
+    UT_CHECK(queue.Pop(&element, 10) == ADSP_SUCCESS && element == (const void*)3);
+    UT_CHECK(queue.Pop(&element, 0) == ADSP_SUCCESS && element == (const void*)4);
+    UT_CHECK(script.steps == 0);
+
+    WaitableQueue no_wheel(buffer, 2);
+    UT_CHECK(no_wheel.Pop(&element, 5) == ADSP_ERROR_INVALID_PARAM);
+}
+
+int main()
+{
+    test_timeout(0, 10);
+    test_timeout(0, 1);
+    // counter wraps during the wait
+    test_timeout(0xFFFFFFF0, 40);
+    // longer than MAX_DELAY, the wheel parks the timer
+    test_timeout(12345, TimingWheel::MAX_DELAY + 100);
+    test_wake_by_push();
+    test_stolen_element();
+    test_non_blocking();
+    return ut_result();
+}
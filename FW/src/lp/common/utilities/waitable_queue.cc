@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#include "adsp_std_defs.h"
+#include "waitable_queue.h"
+#include "core/core_context.h"
+#include "scheduler/dp_scheduler/thread_conditional_block.h"
+
+namespace dsp_fw
+{
+
+WaitableQueue::WaitableQueue(const void** buffer, size_t size, TimingWheel* wheel)
+    : waiters_head_(NULL), waiters_tail_(NULL), wheel_(wheel)
+{
+    QueueInit(&queue_, buffer, size);
+}
+
+void WaitableQueue::Enqueue(Waiter* waiter, bool at_head)
+{
+    if (at_head)
+    {
+        waiter->next = waiters_head_;
+        waiters_head_ = waiter;
+        if (waiters_tail_ == NULL)
+            waiters_tail_ = waiter;
+        return;
+    }
+    waiter->next = NULL;
+    if (waiters_tail_ != NULL)
+        waiters_tail_->next = waiter;
+    else
+        waiters_head_ = waiter;
+    waiters_tail_ = waiter;
+}
+
+void WaitableQueue::Unlink(Waiter* waiter)
+{
+    Waiter* previous = NULL;
+    for (Waiter* it = waiters_head_; it != NULL; previous = it, it = it->next)
+    {
+        if (it != waiter)
+            continue;
+        if (previous != NULL)
+            previous->next = it->next;
+        else
+            waiters_head_ = it->next;
+        if (waiters_tail_ == it)
+            waiters_tail_ = previous;
+        return;
+    }
+}
+
+void WaitableQueue::OnTimeout(void* context)
+{
+    // called from timer tick, waiter is still blocked and its stack frame valid
+    Waiter* waiter = (Waiter*)context;
+    waiter->queue->Unlink(waiter);
+    waiter->signaled = 1;
+}
+
+ErrorCode WaitableQueue::Push(const void* element)
+{
+    ENTER_CRITICAL_SECTION(0);
+    const ErrorCode ec = ::Push(&queue_, element);
+    Waiter* waiter = waiters_head_;
+    if (ec == ADSP_SUCCESS && waiter != NULL)
+    {
+        waiters_head_ = waiter->next;
+        if (waiters_head_ == NULL)
+            waiters_tail_ = NULL;
+        waiter->signaled = 1;
+    }
+    LEAVE_CRITICAL_SECTION(0);
+    return ec;
+}
+
+ErrorCode WaitableQueue::Pop(const void** element, uint32_t timeout_ticks)
+{
+    const bool forever = timeout_ticks == WAIT_FOREVER;
+    RETURN_EC_ON_FAIL(forever || timeout_ticks == 0 || wheel_ != NULL, ADSP_ERROR_INVALID_PARAM);
+    // elapsed time is counted in unsigned ticks, so any timeout below WAIT_FOREVER works across wrap
+    const uint32_t start = wheel_ != NULL ? wheel_->GetTicks() : 0;
+    bool woken = false;
+
+    for (;;)
+    {
+        Waiter waiter;
+        waiter.queue = this;
+        waiter.signaled = 0;
+
+        ENTER_CRITICAL_SECTION(0);
+        if (!IsFree(&queue_))
+        {
+            const ErrorCode ec = ::Pop(&queue_, element);
+            LEAVE_CRITICAL_SECTION(0);
+            return ec;
+        }
+        const uint32_t elapsed = wheel_ != NULL ? wheel_->GetTicks() - start : 0;
+        if (!forever && elapsed >= timeout_ticks)
+        {
+            LEAVE_CRITICAL_SECTION(0);
+            return ADSP_SIMPLE_QUEUE_EMPTY;
+        }
+        // waiter woken by Push() whose element was taken by a non-blocking Pop()
+        // meanwhile keeps its place at the head
+        Enqueue(&waiter, woken);
+        if (!forever)
+            wheel_->Start(&waiter.timer, timeout_ticks - elapsed, OnTimeout, &waiter);
+        LEAVE_CRITICAL_SECTION(0);
+
+        const size_t cached_int_level = _xtos_get_intlevel();
+        HALT_ON_FAIL(cached_int_level == 0);
+        {
+            BlockCurrentThreadedTask blockade(&waiter.signaled, 1);
+        }
+
+        if (!forever)
+            wheel_->Cancel(&waiter.timer);
+        // woken by Push() or by the timeout, the queue is checked once more either way
+        woken = true;
+    }
+}
+
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2021 Intel Corporation. All rights reserved.
+
+#ifndef ADSP_FW_UTILITIES_WAITABLE_QUEUE_H
+#define ADSP_FW_UTILITIES_WAITABLE_QUEUE_H
+
+#include "queue.h"
+#include "timing_wheel.h"
+
+namespace dsp_fw
+{
+
+/*!
+  \brief SimpleQueue whose consumers block instead of polling IsFree().
+
+  Pop() blocks the calling ThreadedTask with BlockCurrentThreadedTask until an
+  element arrives or the timeout expires. Waiters are served in arrival order and
+  every successful Push() wakes exactly one of them, so no thundering herd. A
+  woken waiter whose element was taken by a non-blocking Pop() first goes back
+  to the head of the queue.
+  Push() may be called from threads and interrupt handlers.
+
+  Timeouts are counted in ticks of the TimingWheel given at construction,
+  without wheel only non-blocking and infinite waits are available.
+
+  Example:
+  \code
+      WaitableQueue work(buffer, sizeof(buffer) / sizeof(buffer[0]), &core_timing_wheel);
+      // producer
+      work.Push(request);
+      // worker thread
+      if (work.Pop(&request, timeout_ticks) == ADSP_SIMPLE_QUEUE_EMPTY) HandleTimeout();
+  \endcode
+
+  \note Protects against threads and interrupts of the same core only.
+*/
+class WaitableQueue
+{
+public:
+    static const uint32_t WAIT_FOREVER = 0xFFFFFFFF;
+
+    WaitableQueue(const void** buffer, size_t size, TimingWheel* wheel = NULL);
+
+    /*!
+      \brief Push element and wake the longest waiting consumer, if any.
+      \return ADSP_SIMPLE_QUEUE_FULL when queue is full
+    */
+    ErrorCode Push(const void* element);
+
+    /*!
+      \brief Retrieve the oldest element, waiting up to timeout_ticks for one.
+      \param  element       <out> container for retrieved element. Can be NULL.
+      \param  timeout_ticks 0 does not block, WAIT_FOREVER blocks until an element arrives
+      \return ADSP_SIMPLE_QUEUE_EMPTY when timeout expired with queue still empty
+      \return ADSP_ERROR_INVALID_PARAM for finite timeout without timing wheel
+    */
+    ErrorCode Pop(const void** element, uint32_t timeout_ticks = WAIT_FOREVER);
+
+    uint32_t GetElementsCount() const
+    {
+        return ::GetElementsCount(&queue_);
+    }
+
+private:
+    WaitableQueue(const WaitableQueue&);
+    const WaitableQueue& operator=(const WaitableQueue&);
+
+    /*!
+      \brief Blocked consumer, lives on its stack for the duration of the wait.
+    */
+    struct Waiter
+    {
+        Waiter* next;
+        WaitableQueue* queue;
+        // BlockCurrentThreadedTask waits for 1
+        volatile uint32_t signaled;
+        WheelTimer timer;
+    };
+
+    static void OnTimeout(void* context);
+    void Enqueue(Waiter* waiter, bool at_head);
+    void Unlink(Waiter* waiter);
+
+    SimpleQueue queue_;
+    // FIFO of blocked consumers
+    Waiter* waiters_head_;
+    Waiter* waiters_tail_;
+    TimingWheel* wheel_;
+};
+
+}
+
+#endif // ADSP_FW_UTILITIES_WAITABLE_QUEUE_H